@@ -1,15 +1,32 @@
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "kauf_rgbww.h"
 
+#include <cstring>
+
+#ifdef USE_LIGHT_UDP
+#include <WiFiUdp.h>
+#endif
+
 namespace esphome {
 namespace kauf_rgbww {
 
 static const char *TAG = "kauf_rgbww.light";
 
+// how often the leader repeats its last levels while they don't change
+static const uint32_t DDP_RESEND_INTERVAL_MS = 1000;
+
 void KaufRGBWWLight::setup() {
 
 }
 
+// only registered as a component with followers, see light.py
+void KaufRGBWWLight::loop() {
+    if ( this->ddp_levels_sent_ && millis() - this->ddp_last_send_ms_ >= DDP_RESEND_INTERVAL_MS ) {
+        this->send_ddp_levels_(this->ddp_levels_);
+    }
+}
+
 light::LightTraits KaufRGBWWLight::get_traits() {
     auto traits = light::LightTraits();
 
@@ -43,6 +60,31 @@ void KaufRGBWWLight::write_state(light::LightState *state) {
         return;
     }
 
+    // pixels with white channels received via WLED DDP go straight to the outputs.  A single white channel
+    // is split between cold and warm white by the last color temp.
+    // Deliberately uncalibrated: no max_blue / max_white here, the sender controls the outputs exactly.  Leader
+    // bulbs send their already calibrated output levels this way, scaling them again would dim the followers.
+    if ( state->current_values.use_raw &&
+         ( (state->current_values.get_color_mode() == light::ColorMode::RGB_WHITE) ||
+           (state->current_values.get_color_mode() == light::ColorMode::RGB_COLD_WARM_WHITE) ) ) {
+
+        float cold, warm;
+        if ( state->current_values.get_color_mode() == light::ColorMode::RGB_WHITE ) {
+            cold = state->current_values.get_white() * (1-ct);
+            warm = state->current_values.get_white() * ct;
+        } else {
+            cold = state->current_values.get_cold_white();
+            warm = state->current_values.get_warm_white();
+        }
+
+        ESP_LOGV("Kauf Light", "Setting DDP Levels - R:%f G:%f B:%f CW:%f WW:%f)", state->current_values.get_red(),
+                 state->current_values.get_green(), state->current_values.get_blue(), cold, warm);
+
+        this->set_levels_(state->current_values.get_red(), state->current_values.get_green(),
+                          state->current_values.get_blue(), cold, warm);
+        return;
+    }
+
     float red, green, blue;
     float white_brightness;
 
@@ -146,19 +188,89 @@ void KaufRGBWWLight::write_state(light::LightState *state) {
     ESP_LOGV("Kauf Light", "Setting Levels - R:%f G:%f B:%f CW:%f WW:%f)", scaled_red, scaled_green, scaled_blue, scaled_cold, scaled_warm);
 
     // set outputs
-    this->red_->set_level(scaled_red);
-    this->green_->set_level(scaled_green);
-    this->blue_->set_level(scaled_blue);
-    this->cold_white_->set_level(scaled_cold);
-    this->warm_white_->set_level(scaled_warm);
+    this->set_levels_(scaled_red, scaled_green, scaled_blue, scaled_cold, scaled_warm);
 
 //  }
 
 
 }
 
+void KaufRGBWWLight::set_levels_(float red, float green, float blue, float cold_white, float warm_white) {
+
+    this->red_->set_level(red);
+    this->green_->set_level(green);
+    this->blue_->set_level(blue);
+    this->cold_white_->set_level(cold_white);
+    this->warm_white_->set_level(warm_white);
+
+    if ( !this->ddp_followers_.empty() ) {
+        const float levels[5] = {red, green, blue, cold_white, warm_white};
+        this->send_ddp_levels_(levels);
+    }
+}
+
+// Followers get the final output levels, after gamma, aux light blending and color temp, as a single 16 bit
+// RGB + cold white + warm white pixel.  They write those straight to their outputs, so the whole group shows
+// exactly the same frame, every step of transitions and effects included.
+void KaufRGBWWLight::send_ddp_levels_(const float levels[5]) {
+#ifdef USE_LIGHT_UDP
+
+    // kept for the resend, a fresh sequence number and timecode each time so followers take it as a new frame
+    if ( levels != this->ddp_levels_ ) {
+        memcpy(this->ddp_levels_, levels, sizeof(this->ddp_levels_));
+    }
+    this->ddp_levels_sent_ = true;
+    this->ddp_last_send_ms_ = millis();
+
+    // sequence number counts 1-15, 0 would tell the followers sequence numbers aren't used.
+    this->ddp_sequence_ = (this->ddp_sequence_ % 15) + 1;
+
+    // timecode is millis() in DDP's 1/65536 second units, followers with a jitter buffer schedule the frame by it.
+    const uint32_t timecode = uint32_t(uint64_t(millis()) * 65536u / 1000u);
+
+    uint8_t packet[24] = {
+        0x51,                        // flags: version 1, timecode, push
+        this->ddp_sequence_,         // sequence number
+        0x9C,                        // data type: 16 bit RGB + cold white + warm white
+        0x01,                        // destination ID: default output device
+        0x00, 0x00, 0x00, 0x00,      // data offset
+        0x00, 0x0A,                  // data length: 5 channels, 2 bytes each
+        uint8_t(timecode >> 24), uint8_t(timecode >> 16), uint8_t(timecode >> 8), uint8_t(timecode),
+    };
+
+    for (uint8_t i = 0; i < 5; i++) {
+        const uint16_t level = uint16_t(clamp(levels[i], 0.0f, 1.0f) * 65535.0f + 0.5f);
+        packet[14 + 2*i] = level >> 8;
+        packet[15 + 2*i] = level & 0xFF;
+    }
+
+    if ( !this->ddp_udp_ ) {
+        this->ddp_udp_ = make_unique<WiFiUDP>();
+    }
+    for (const auto &follower : this->ddp_followers_) {
+        if ( !this->ddp_udp_->beginPacket(follower.c_str(), 4048) ) {
+            ESP_LOGE("KAUF Leader", "Error beginning DDP packet to %s!", follower.c_str());
+            continue;
+        }
+        this->ddp_udp_->write(packet, sizeof(packet));
+        if ( !this->ddp_udp_->endPacket() ) {
+            ESP_LOGE("KAUF Leader", "Error ending DDP packet to %s!", follower.c_str());
+        }
+    }
+
+#endif
+}
+
 void KaufRGBWWLight::dump_config(){
     ESP_LOGCONFIG(TAG, "Kauf RGBWW custom light");
+    for (const auto &follower : this->ddp_followers_) {
+        ESP_LOGCONFIG(TAG, "  DDP Follower: %s", follower.c_str());
+    }
+#ifndef USE_LIGHT_UDP
+    if ( !this->ddp_followers_.empty() ) {
+        ESP_LOGW(TAG, "DDP followers are only supported on ESP8266");
+    }
+#endif
 }
 
 } //namespace kauf_rgbww
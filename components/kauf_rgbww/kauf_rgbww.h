@@ -4,12 +4,16 @@
 #include "esphome/components/output/float_output.h"
 #include "esphome/components/light/light_output.h"
 
+#include <string>
+#include <vector>
+
 namespace esphome {
 namespace kauf_rgbww {
 
 class KaufRGBWWLight : public light::LightOutput, public Component {
  public:
   void setup() override;
+  void loop() override;
   light::LightTraits get_traits() override;
 
   void set_red(output::FloatOutput *red) { red_ = red; }
@@ -30,6 +34,10 @@ class KaufRGBWWLight : public light::LightOutput, public Component {
   void set_cold_rgb(light::LightState *cold_rgb_in) { cold_rgb = cold_rgb_in; }
   void set_warm_rgb(light::LightState *warm_rgb_in) { warm_rgb = warm_rgb_in; }
 
+  // leader mode: every write is also sent as DDP to these bulbs, which need WLED/DDP enabled to show it.
+  // the last levels are sent again every second, so a follower that lost a packet or just booted catches up.
+  void add_ddp_follower(const std::string &address) { ddp_followers_.push_back(address); }
+
 
  protected:
   output::FloatOutput *red_;
@@ -48,6 +56,19 @@ class KaufRGBWWLight : public light::LightOutput, public Component {
 
   float ct = .5;         // CT variable declared up here so that it gets saved across calls to write_state.
 
+  // set the PWM outputs, and send the same levels to the followers
+  void set_levels_(float red, float green, float blue, float cold_white, float warm_white);
+  void send_ddp_levels_(const float levels[5]);
+
+  std::vector<std::string> ddp_followers_;
+  uint8_t ddp_sequence_{0};
+  float ddp_levels_[5];
+  bool ddp_levels_sent_{false};
+  uint32_t ddp_last_send_ms_{0};
+#ifdef USE_LIGHT_UDP
+  std::unique_ptr<WiFiUDP> ddp_udp_;
+#endif
+
 };
 
 } //namespace kauf_rgbww
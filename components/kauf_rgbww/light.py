@@ -16,7 +16,7 @@ from esphome.const import (
 )
 
 kauf_rgbww_ns = cg.esphome_ns.namespace('kauf_rgbww')
-KaufRGBWWLight = kauf_rgbww_ns.class_('KaufRGBWWLight', light.LightOutput)
+KaufRGBWWLight = kauf_rgbww_ns.class_('KaufRGBWWLight', light.LightOutput, cg.Component)
 
 def validate_kauf_light(value):
     if (value["aux"]):
@@ -34,6 +34,8 @@ def validate_kauf_light(value):
             raise cv.Invalid("Aux KAUF Light should not have a warm_rgb light.")
         if ( "cold_rgb" in value ):
             raise cv.Invalid("Aux KAUF Light should not have a cold_rgb light.")
+        if ( "ddp_followers" in value ):
+            raise cv.Invalid("Aux KAUF Light should not have DDP followers.")
 
     else:
         if ( "red" not in value ):
@@ -70,6 +72,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional("cold_rgb"): cv.use_id(light.LightState),
             cv.Optional("warm_rgb"): cv.use_id(light.LightState),
             cv.Optional("aux", default=False): cv.boolean,
+            cv.Optional("ddp_followers"): cv.ensure_list(cv.ipv4),
         }
     ),
     cv.has_none_or_all_keys(
@@ -141,5 +144,11 @@ async def to_code(config):
         wwhite = await cg.get_variable(config[CONF_WARM_WHITE])
         cg.add(var.set_warm_white(wwhite))
 
+        # leader mode, stream output levels to follower bulbs.  the loop only resends them, so only then a component
+        for follower in config.get("ddp_followers", []):
+            cg.add(var.add_ddp_follower(str(follower)))
+        if config.get("ddp_followers"):
+            await cg.register_component(var, config)
+
     # register light
     await light.register_light(var, config)
@@ -1,3 +1,5 @@
+import math
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
 import esphome.automation as auto
@@ -20,7 +22,7 @@ from esphome.const import (
     CONF_COLD_WHITE_COLOR_TEMPERATURE,
     CONF_WARM_WHITE_COLOR_TEMPERATURE,
 )
-from esphome.core import coroutine_with_priority
+from esphome.core import CORE, ID, TimePeriod, coroutine_with_priority
 from esphome.cpp_helpers import setup_entity
 from .automation import light_control_to_code  # noqa
 from .effects import (
@@ -45,6 +47,11 @@ from .types import (  # noqa
 CODEOWNERS = ["@esphome/core"]
 IS_PLATFORM_COMPONENT = True
 
+DOMAIN = "light"
+
+# number of entries of the gamma table for PWM lights, values in between are interpolated
+PWM_GAMMA_TABLE_SIZE = 1024
+
 LightRestoreMode = light_ns.enum("LightRestoreMode")
 RESTORE_MODES = {
     "RESTORE_DEFAULT_OFF": LightRestoreMode.LIGHT_RESTORE_DEFAULT_OFF,
@@ -87,6 +94,16 @@ LIGHT_SCHEMA = (
         cv.Optional("forced_hash"): cv.int_,
         cv.Optional("forced_addr"): cv.int_,
         cv.Optional("global_addr"): cv.use_id(globals),
+        cv.Optional("loop_profiler", default=False): cv.boolean,
+        cv.Optional("e131_universe"): cv.int_range(min=1, max=63999),
+        cv.Optional("artnet_universe"): cv.int_range(min=0, max=32767),
+        cv.Optional("dmx_start_channel", default=1): cv.int_range(min=1, max=512),
+        cv.Optional("dmx_channels", default=3): cv.int_range(min=3, max=5),
+        cv.Optional("ddp_jitter_buffer"): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(max=TimePeriod(milliseconds=250)),
+        ),
+        cv.Optional("ddp_ntp_clock", default=False): cv.boolean,
         }
     )
 )
@@ -142,6 +159,50 @@ def validate_color_temperature_channels(value):
     return value
 
 
+def _gamma_correct(value, gamma):
+    # same as gamma_correct() in esphome/core/helpers.h
+    if value <= 0:
+        return 0.0
+    if gamma <= 0:
+        return value
+    return math.pow(value, gamma)
+
+
+def _to_scale(value, max_value):
+    return int(math.floor(value * max_value + 0.5))
+
+
+def _gamma_table(kind, gamma, type_, values):
+    # Tables only depend on the gamma, so lights with the same gamma share one table.
+    tables = CORE.data.setdefault(DOMAIN, {}).setdefault("gamma_tables", {})
+    key = (kind, gamma)
+    if key not in tables:
+        name = f"light_{kind}_gamma_table_{gamma:g}".replace(".", "_")
+        table_id = ID(name, is_declaration=True, type=type_)
+        tables[key] = cg.progmem_array(table_id, values)
+    return tables[key]
+
+
+def addressable_gamma_table(gamma):
+    """256 forward entries followed by 256 reverse entries, see ESPColorCorrection::calculate_gamma_table()."""
+    forward = [_to_scale(_gamma_correct(i / 255, gamma), 255) for i in range(256)]
+    if gamma == 0:
+        reverse = list(range(256))
+    else:
+        reverse = [_to_scale(math.pow(i / 255, 1 / gamma), 255) for i in range(256)]
+    return _gamma_table("addressable", gamma, cg.uint8, forward + reverse)
+
+
+def pwm_gamma_table(gamma):
+    """Gamma corrected output levels scaled to 16 bits, see LightState::gamma_correct_lookup_()."""
+    last = PWM_GAMMA_TABLE_SIZE - 1
+    values = [
+        _to_scale(_gamma_correct(i / last, gamma), 65535)
+        for i in range(PWM_GAMMA_TABLE_SIZE)
+    ]
+    return _gamma_table("pwm", gamma, cg.uint16, values)
+
+
 async def setup_light_core_(light_var, output_var, config):
     await setup_entity(light_var, config)
 
@@ -157,6 +218,10 @@ async def setup_light_core_(light_var, output_var, config):
         cg.add(light_var.set_flash_transition_length(flash_transition_length))
     if (gamma_correct := config.get(CONF_GAMMA_CORRECT)) is not None:
         cg.add(light_var.set_gamma_correct(gamma_correct))
+        if config[CONF_ID].type.inherits_from(AddressableLightState):
+            cg.add(output_var.set_gamma_table(addressable_gamma_table(gamma_correct)))
+        else:
+            cg.add(light_var.set_gamma_table(pwm_gamma_table(gamma_correct)))
     effects = await cg.build_registry_list(
         EFFECTS_REGISTRY, config.get(CONF_EFFECTS, [])
     )
@@ -198,6 +263,27 @@ async def setup_light_core_(light_var, output_var, config):
         ga = await cg.get_variable(config["global_addr"])
         cg.add(light_var.set_global_addr(ga))
 
+    # E1.31 / Art-Net receivers, running whenever DDP is enabled
+    if "e131_universe" in config:
+        cg.add(light_var.set_e131_universe(config["e131_universe"]))
+    if "artnet_universe" in config:
+        cg.add(light_var.set_artnet_universe(config["artnet_universe"]))
+    if "e131_universe" in config or "artnet_universe" in config:
+        cg.add(light_var.set_dmx_start_channel(config["dmx_start_channel"]))
+        cg.add(light_var.set_dmx_channels(config["dmx_channels"]))
+
+    if "ddp_jitter_buffer" in config:
+        cg.add(light_var.set_ddp_jitter_buffer(config["ddp_jitter_buffer"]))
+    # DDP timecodes are NTP time, schedule them by the system clock (set by an sntp time component)
+    if config["ddp_ntp_clock"]:
+        cg.add(light_var.set_ddp_ntp_clock(True))
+
+    # opt-in cycle count histograms for each stage of LightState::loop(). The define builds the profiler in, only
+    # the lights with the option allocate the histograms and record.
+    if config["loop_profiler"]:
+        cg.add_define("USE_LIGHT_LOOP_PROFILER")
+        cg.add(light_var.set_loop_profiler(True))
+
 
 async def register_light(output_var, config):
     light_var = cg.new_Pvariable(config[CONF_ID], output_var)
@@ -27,7 +27,7 @@ std::unique_ptr<LightTransformer> AddressableLight::create_default_transition()
   return make_unique<AddressableLightTransformer>(*this);
 }
 
-Color color_from_light_color_values(LightColorValues val) {
+Color color_from_light_color_values(const LightColorValues &val) {
   auto r = to_uint8_scale(val.get_color_brightness() * val.get_red());
   auto g = to_uint8_scale(val.get_color_brightness() * val.get_green());
   auto b = to_uint8_scale(val.get_color_brightness() * val.get_blue());
@@ -36,7 +36,7 @@ Color color_from_light_color_values(LightColorValues val) {
 }
 
 void AddressableLight::update_state(LightState *state) {
-  auto val = state->current_values;
+  const auto &val = state->current_values;
   auto max_brightness = to_uint8_scale(val.get_brightness() * val.get_state());
   this->correction_.set_local_brightness(max_brightness);
 
@@ -49,11 +49,15 @@ void AddressableLight::update_state(LightState *state) {
 }
 
 void AddressableLightTransformer::start() {
+  // the transformer is reused for later transitions, so start from scratch
+  this->last_transition_progress_ = 0.0f;
+  this->accumulated_alpha_ = 0.0f;
+
   // don't try to transition over running effects.
   if (this->light_.is_effect_active())
     return;
 
-  auto end_values = this->target_values_;
+  const auto &end_values = this->target_values_;
   this->target_color_ = color_from_light_color_values(end_values);
 
   // our transition will handle brightness, disable brightness in correction.
@@ -96,11 +100,12 @@ optional<LightColorValues> AddressableLightTransformer::apply() {
   auto alpha8 = static_cast<uint8_t>(alpha255);
 
   if (alpha8 != 0) {
-    uint8_t inv_alpha8 = 255 - alpha8;
-    Color add = this->target_color_ * alpha8;
+    // Every LED still goes through get() and set(), which uncorrect and correct it. Blending the corrected values
+    // directly would fade along the gamma curve instead of linearly, so only the blend itself is sped up.
+    const Color add = this->target_color_ * alpha8;
 
     for (auto led : this->light_)
-      led.set(add + led.get() * inv_alpha8);
+      led.set(blend(led.get(), add, alpha8));
   }
 
   this->last_transition_progress_ = smoothed_progress;
@@ -109,5 +114,17 @@ optional<LightColorValues> AddressableLightTransformer::apply() {
   return {};
 }
 
+Color AddressableLightTransformer::blend(const Color &current, const Color &add, uint8_t alpha8) {
+  // The red/blue and green/white bytes are each scaled as two 16-bit lanes of a 32-bit word. Scaling by 256 - alpha8
+  // matches esp_scale8(c, 255 - alpha8), and the two scaled terms never sum above 255, so no lane can carry into the
+  // next.
+  const uint32_t inv_scale = 256u - alpha8;
+  const uint32_t rb = (((current.raw_32 & 0x00FF00FFu) * inv_scale) >> 8) & 0x00FF00FFu;
+  const uint32_t gw = (((current.raw_32 >> 8) & 0x00FF00FFu) * inv_scale) & 0xFF00FF00u;
+  Color blended;
+  blended.raw_32 = add.raw_32 + rb + gw;
+  return blended;
+}
+
 }  // namespace light
 }  // namespace esphome
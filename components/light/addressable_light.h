@@ -20,7 +20,7 @@ namespace light {
 using ESPColor ESPDEPRECATED("esphome::light::ESPColor is deprecated, use esphome::Color instead.", "v1.21") = Color;
 
 /// Convert the color information from a `LightColorValues` object to a `Color` object (does not apply brightness).
-Color color_from_light_color_values(LightColorValues val);
+Color color_from_light_color_values(const LightColorValues &val);
 
 /// Use a custom state class for addressable lights, to allow type system to discriminate between addressable and
 /// non-addressable lights.
@@ -31,8 +31,8 @@ class AddressableLightState : public LightState {
 class AddressableLight : public LightOutput, public Component {
  public:
   virtual int32_t size() const = 0;
-  ESPColorView operator[](int32_t index) const { return this->get_view_internal(interpret_index(index, this->size())); }
-  ESPColorView get(int32_t index) { return this->get_view_internal(interpret_index(index, this->size())); }
+  ESPColorView operator[](int32_t index) const { return this->view_(interpret_index(index, this->size())); }
+  ESPColorView get(int32_t index) { return this->view_(interpret_index(index, this->size())); }
   virtual void clear_effect_data() = 0;
   ESPRangeView range(int32_t from, int32_t to) {
     from = interpret_index(from, this->size());
@@ -68,8 +68,14 @@ class AddressableLight : public LightOutput, public Component {
     this->correction_.set_max_brightness(
         Color(to_uint8_scale(red), to_uint8_scale(green), to_uint8_scale(blue), to_uint8_scale(white)));
   }
+  /// Use gamma tables generated at compile time instead of computing them at setup, see load_gamma_table().
+  void set_gamma_table(const uint8_t *gamma_table) { this->gamma_table_ = gamma_table; }
   void setup_state(LightState *state) override {
-    this->correction_.calculate_gamma_table(state->get_gamma_correct());
+    if (this->gamma_table_ != nullptr) {
+      this->correction_.load_gamma_table(this->gamma_table_);
+    } else {
+      this->correction_.calculate_gamma_table(state->get_gamma_correct());
+    }
     this->state_parent_ = state;
   }
   void update_state(LightState *state) override;
@@ -83,28 +89,52 @@ class AddressableLight : public LightOutput, public Component {
 
  protected:
   friend class AddressableLightTransformer;
+  // the range views resolve indices themselves and go straight to view_() and the color correction
+  friend class ESPRangeView;
+  friend class ESPRangeIterator;
 
   void mark_shown_() {
 #ifdef USE_POWER_SUPPLY
-    for (const auto &c : *this) {
-      if (c.get_red_raw() > 0 || c.get_green_raw() > 0 || c.get_blue_raw() > 0 || c.get_white_raw() > 0) {
-        this->power_.request();
-        return;
+    // The views count lit pixels as they're written, so while the strip is on this doesn't look at any pixel. A driver
+    // or effect can also write the buffer around the views, so a count that dropped to zero is checked by counting
+    // again: the power supply may stay on for a dark strip that way, but never goes off for a lit one.
+    if (this->lit_count_ <= 0) {
+      this->lit_count_ = 0;
+      for (int32_t i = 0; i < this->size(); i++) {
+        if (this->get_view_internal(i).get_raw().raw_32 != 0)
+          this->lit_count_++;
       }
     }
-    this->power_.unrequest();
+    if (this->lit_count_ > 0) {
+      this->power_.request();
+    } else {
+      this->power_.unrequest();
+    }
 #endif
   }
+  /// The platform's view of a pixel, counting lit pixels for mark_shown_() when there is a power supply.
+  ESPColorView view_(int32_t index) const {
+    ESPColorView view = this->get_view_internal(index);
+#ifdef USE_POWER_SUPPLY
+    view.raw_set_lit_count(&this->lit_count_);
+#endif
+    return view;
+  }
   virtual ESPColorView get_view_internal(int32_t index) const = 0;
 
   bool effect_active_{false};
   ESPColorCorrection correction_{};
+  const uint8_t *gamma_table_{nullptr};
 #ifdef USE_POWER_SUPPLY
   power_supply::PowerSupplyRequester power_;
+  mutable int32_t lit_count_{0};
 #endif
   LightState *state_parent_{nullptr};
 };
 
+// defined here rather than in esp_range_view.cpp, so range-based for loops over a range get it inlined
+inline ESPColorView ESPRangeIterator::operator*() const { return this->range_.parent_->view_(this->i_); }
+
 class AddressableLightTransformer : public LightTransitionTransformer {
  public:
   AddressableLightTransformer(AddressableLight &light) : light_(light) {}
@@ -112,6 +142,10 @@ class AddressableLightTransformer : public LightTransitionTransformer {
   void start() override;
   optional<LightColorValues> apply() override;
 
+  /// One step of the transition for a pixel: add + current * (255 - alpha8), add being the target scaled by alpha8.
+  /// The same as with Color's operators, but all four channels at once.
+  static Color blend(const Color &current, const Color &add, uint8_t alpha8);
+
  protected:
   AddressableLight &light_;
   Color target_color_{};
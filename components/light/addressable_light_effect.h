@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -46,6 +47,16 @@ class AddressableLightEffect : public LightEffect {
 
  protected:
   AddressableLight *get_addressable_() const { return (AddressableLight *) this->state_->get_output(); }
+
+  /// Color::random_color() of ESPHome core, but drawn from the random number generator of this effect. Core's Color
+  /// unpacks the random word (white in the top byte) and esp_scale() brings the brightest channel up to 255.
+  Color random_color_() {
+    const Color c(this->random_uint32_());
+    const uint8_t max_rgb = std::max(c.r, std::max(c.g, c.b));
+    if (max_rgb == 0)
+      return Color(255, 255, 255, c.w);
+    return Color(esp_scale(c.r, max_rgb), esp_scale(c.g, max_rgb), esp_scale(c.b, max_rgb), c.w);
+  }
 };
 
 class AddressableLambdaLightEffect : public AddressableLightEffect {
@@ -62,6 +73,7 @@ class AddressableLambdaLightEffect : public AddressableLightEffect {
       this->f_(it, current_color, this->initial_run_);
       this->initial_run_ = false;
       it.schedule_show();
+      this->wake_at_(now + this->update_interval_);
     }
   }
 
@@ -75,17 +87,10 @@ class AddressableLambdaLightEffect : public AddressableLightEffect {
 class AddressableRainbowLightEffect : public AddressableLightEffect {
  public:
   explicit AddressableRainbowLightEffect(const std::string &name) : AddressableLightEffect(name) {}
+  void start() override { rainbow_table_(); }
   void apply(AddressableLight &it, const Color &current_color) override {
-    ESPHSVColor hsv;
-    hsv.value = 255;
-    hsv.saturation = 240;
-    uint16_t hue = (millis() * this->speed_) % 0xFFFF;
-    const uint16_t add = 0xFFFF / this->width_;
-    for (auto var : it) {
-      hsv.hue = hue >> 8;
-      var = hsv;
-      hue += add;
-    }
+    const uint16_t hue = (millis() * this->speed_) % 0xFFFF;
+    it.all().set_ramp(rainbow_table_(), hue, 0xFFFF / this->width_);
     it.schedule_show();
   }
   void set_speed(uint32_t speed) { this->speed_ = speed; }
@@ -94,6 +99,22 @@ class AddressableRainbowLightEffect : public AddressableLightEffect {
  protected:
   uint32_t speed_{10};
   uint16_t width_{50};
+
+  /// Every hue as RGB, shared by all rainbow effects: saturation and value never change, so each hue is converted
+  /// once instead of for every LED in every frame.
+  static const Color *rainbow_table_() {
+    static Color table[256];
+    static bool converted = false;
+    if (!converted) {
+      ESPHSVColor hsv(0, 240, 255);
+      for (uint16_t hue = 0; hue < 256; hue++) {
+        hsv.hue = hue;
+        table[hue] = hsv.to_rgb();
+      }
+      converted = true;
+    }
+    return table;
+  }
 };
 
 struct AddressableColorWipeEffectColor {
@@ -113,6 +134,7 @@ class AddressableColorWipeEffect : public AddressableLightEffect {
     if (now - this->last_add_ < this->add_led_interval_)
       return;
     this->last_add_ = now;
+    this->wake_at_(now + this->add_led_interval_);
     if (this->reverse_)
       it.shift_left(1);
     else
@@ -128,7 +150,7 @@ class AddressableColorWipeEffect : public AddressableLightEffect {
       this->at_color_ = (this->at_color_ + 1) % this->colors_.size();
       AddressableColorWipeEffectColor &new_color = this->colors_[this->at_color_];
       if (new_color.random) {
-        Color c = Color::random_color();
+        Color c = this->random_color_();
         new_color.r = c.r;
         new_color.g = c.g;
         new_color.b = c.b;
@@ -166,6 +188,7 @@ class AddressableScanEffect : public AddressableLightEffect {
         this->direction_ = true;
     }
     this->last_move_ = now;
+    this->wake_at_(now + this->move_interval_);
 
     it.all() = Color::BLACK;
     for (uint32_t i = 0; i < this->scan_width_; i++) {
@@ -207,8 +230,8 @@ class AddressableTwinkleEffect : public AddressableLightEffect {
         view = Color::BLACK;
       }
     }
-    while (random_float() < this->twinkle_probability_) {
-      const size_t pos = random_uint32() % addressable.size();
+    while (this->random_float_() < this->twinkle_probability_) {
+      const size_t pos = this->random_uint32_() % addressable.size();
       if (addressable[pos].get_effect_data() != 0)
         continue;
       addressable[pos].set_effect_data(1);
@@ -254,11 +277,11 @@ class AddressableRandomTwinkleEffect : public AddressableLightEffect {
         view = Color(0, 0, 0, 0);
       }
     }
-    while (random_float() < this->twinkle_probability_) {
-      const size_t pos = random_uint32() % it.size();
+    while (this->random_float_() < this->twinkle_probability_) {
+      const size_t pos = this->random_uint32_() % it.size();
       if (it[pos].get_effect_data() != 0)
         continue;
-      const uint8_t color = random_uint32() & 0b111;
+      const uint8_t color = this->random_uint32_() & 0b111;
       it[pos].set_effect_data(0b1000 | color);
     }
     it.schedule_show();
@@ -284,6 +307,7 @@ class AddressableFireworksEffect : public AddressableLightEffect {
     if (now - this->last_update_ < this->update_interval_)
       return;
     this->last_update_ = now;
+    this->wake_at_(now + this->update_interval_);
     // "invert" the fade out parameter so that higher values make fade out faster
     const uint8_t fade_out_mult = 255u - this->fade_out_rate_;
     for (auto view : it) {
@@ -298,10 +322,10 @@ class AddressableFireworksEffect : public AddressableLightEffect {
       it[i] = (it[i - 1].get() * 64) + it[i].get() + (it[i + 1].get() * 64);
     }
     it[last] = it[last].get() + (it[last - 1].get() * 128);
-    if (random_float() < this->spark_probability_) {
-      const size_t pos = random_uint32() % it.size();
+    if (this->random_float_() < this->spark_probability_) {
+      const size_t pos = this->random_uint32_() % it.size();
       if (this->use_random_color_) {
-        it[pos] = Color::random_color();
+        it[pos] = this->random_color_();
       } else {
         it[pos] = current_color;
       }
@@ -332,7 +356,8 @@ class AddressableFlickerEffect : public AddressableLightEffect {
       return;
 
     this->last_update_ = now;
-    uint32_t rng_state = random_uint32();
+    this->wake_at_(now + this->update_interval_);
+    uint32_t rng_state = this->random_uint32_();
     for (auto var : it) {
       rng_state = (rng_state * 0x9E3779B9) + 0x9E37;
       const uint8_t flicker = (rng_state & 0xFF) % intensity;
@@ -23,6 +23,16 @@ template<typename... Ts> class ToggleAction : public Action<Ts...> {
   LightState *state_;
 };
 
+template<typename... Ts> class DumpLoopProfileAction : public Action<Ts...> {
+ public:
+  explicit DumpLoopProfileAction(LightState *state) : state_(state) {}
+
+  void play(Ts... x) override { this->state_->dump_loop_profile(); }
+
+ protected:
+  LightState *state_;
+};
+
 template<typename... Ts> class LightControlAction : public Action<Ts...> {
  public:
   explicit LightControlAction(LightState *parent) : parent_(parent) {}
@@ -24,6 +24,7 @@ from .types import (
     ColorMode,
     COLOR_MODES,
     DimRelativeAction,
+    DumpLoopProfileAction,
     ToggleAction,
     LightState,
     LightControlAction,
@@ -57,6 +58,20 @@ async def light_toggle_to_code(config, action_id, template_arg, args):
     return var
 
 
+@automation.register_action(
+    "light.dump_loop_profile",
+    DumpLoopProfileAction,
+    automation.maybe_simple_id(
+        {
+            cv.Required(CONF_ID): cv.use_id(LightState),
+        }
+    ),
+)
+async def light_dump_loop_profile_to_code(config, action_id, template_arg, args):
+    paren = await cg.get_variable(config[CONF_ID])
+    return cg.new_Pvariable(action_id, template_arg, paren)
+
+
 LIGHT_CONTROL_ACTION_SCHEMA = cv.Schema(
     {
         cv.Required(CONF_ID): cv.use_id(LightState),
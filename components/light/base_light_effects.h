@@ -9,11 +9,6 @@
 namespace esphome {
 namespace light {
 
-inline static float random_cubic_float() {
-  const float r = random_float() * 2.0f - 1.0f;
-  return r * r * r;
-}
-
 /// Pulse effect.
 class PulseLightEffect : public LightEffect {
  public:
@@ -35,6 +30,7 @@ class PulseLightEffect : public LightEffect {
     call.perform();
 
     this->last_color_change_ = now;
+    this->wake_at_(now + this->update_interval_);
   }
 
   void set_transition_on_length(uint32_t transition_length) { this->transition_on_length_ = transition_length; }
@@ -72,25 +68,25 @@ class RandomLightEffect : public LightEffect {
     auto call = this->state_->turn_on();
     bool changed = false;
     if (color_mode & ColorCapability::RGB) {
-      call.set_red(random_float());
-      call.set_green(random_float());
-      call.set_blue(random_float());
+      call.set_red(this->random_float_());
+      call.set_green(this->random_float_());
+      call.set_blue(this->random_float_());
       changed = true;
     }
     if (color_mode & ColorCapability::COLOR_TEMPERATURE) {
       float min = this->state_->get_traits().get_min_mireds();
       float max = this->state_->get_traits().get_max_mireds();
-      call.set_color_temperature(min + random_float() * (max - min));
+      call.set_color_temperature(min + this->random_float_() * (max - min));
       changed = true;
     }
     if (color_mode & ColorCapability::COLD_WARM_WHITE) {
-      call.set_cold_white(random_float());
-      call.set_warm_white(random_float());
+      call.set_cold_white(this->random_float_());
+      call.set_warm_white(this->random_float_());
       changed = true;
     }
     if (!changed) {
       // only randomize brightness if there's no colored option available
-      call.set_brightness(random_float());
+      call.set_brightness(this->random_float_());
     }
     call.set_transition_length_if_supported(this->transition_length_);
     call.set_publish(true);
@@ -98,6 +94,7 @@ class RandomLightEffect : public LightEffect {
     call.perform();
 
     this->last_color_change_ = now;
+    this->wake_at_(now + this->update_interval_);
   }
 
   void set_transition_length(uint32_t transition_length) { this->transition_length_ = transition_length; }
@@ -122,6 +119,7 @@ class LambdaLightEffect : public LightEffect {
       this->last_run_ = now;
       this->f_(this->initial_run_);
       this->initial_run_ = false;
+      this->wake_at_(now + this->update_interval_);
     }
   }
 
@@ -178,6 +176,7 @@ class StrobeLightEffect : public LightEffect {
     call.set_transition_length_if_supported(this->colors_[this->at_color_].transition_length);
     call.perform();
     this->last_switch_ = now;
+    this->wake_at_(now + this->colors_[this->at_color_].duration);
   }
 
   void set_colors(const std::vector<StrobeLightEffectColor> &colors) { this->colors_ = colors; }
@@ -193,22 +192,25 @@ class FlickerLightEffect : public LightEffect {
   explicit FlickerLightEffect(const std::string &name) : LightEffect(name) {}
 
   void apply() override {
-    LightColorValues remote = this->state_->remote_values;
-    LightColorValues current = this->state_->current_values;
+    const LightColorValues &remote = this->state_->remote_values;
+    const LightColorValues &current = this->state_->current_values;
     LightColorValues out;
     const float alpha = this->alpha_;
     const float beta = 1.0f - alpha;
     out.set_state(true);
     out.set_brightness(remote.get_brightness() * beta + current.get_brightness() * alpha +
-                       (random_cubic_float() * this->intensity_));
-    out.set_red(remote.get_red() * beta + current.get_red() * alpha + (random_cubic_float() * this->intensity_));
-    out.set_green(remote.get_green() * beta + current.get_green() * alpha + (random_cubic_float() * this->intensity_));
-    out.set_blue(remote.get_blue() * beta + current.get_blue() * alpha + (random_cubic_float() * this->intensity_));
-    out.set_white(remote.get_white() * beta + current.get_white() * alpha + (random_cubic_float() * this->intensity_));
+                       (this->random_cubic_float_() * this->intensity_));
+    out.set_red(remote.get_red() * beta + current.get_red() * alpha + (this->random_cubic_float_() * this->intensity_));
+    out.set_green(remote.get_green() * beta + current.get_green() * alpha +
+                  (this->random_cubic_float_() * this->intensity_));
+    out.set_blue(remote.get_blue() * beta + current.get_blue() * alpha +
+                 (this->random_cubic_float_() * this->intensity_));
+    out.set_white(remote.get_white() * beta + current.get_white() * alpha +
+                  (this->random_cubic_float_() * this->intensity_));
     out.set_cold_white(remote.get_cold_white() * beta + current.get_cold_white() * alpha +
-                       (random_cubic_float() * this->intensity_));
+                       (this->random_cubic_float_() * this->intensity_));
     out.set_warm_white(remote.get_warm_white() * beta + current.get_warm_white() * alpha +
-                       (random_cubic_float() * this->intensity_));
+                       (this->random_cubic_float_() * this->intensity_));
 
     out.set_color_temperature(remote.get_color_temperature());
 
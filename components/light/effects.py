@@ -66,6 +66,7 @@ CONF_PROGRESS_INTERVAL = "progress_interval"
 CONF_SPARK_PROBABILITY = "spark_probability"
 CONF_USE_RANDOM_COLOR = "use_random_color"
 CONF_FADE_OUT_RATE = "fade_out_rate"
+CONF_SEED = "seed"
 CONF_STROBE = "strobe"
 CONF_FLICKER = "flicker"
 CONF_ADDRESSABLE_LAMBDA = "addressable_lambda"
@@ -87,6 +88,10 @@ ADDRESSABLE_EFFECTS = []
 
 EFFECTS_REGISTRY = Registry()
 
+# A fixed seed for the effect's random sequence. 0 is what the effects use without
+# one, seeding from the hardware RNG at every start, so it isn't a fixed seed.
+validate_seed = cv.int_range(min=1, max=0xFFFFFFFF)
+
 
 def register_effect(name, effect_type, default_name, schema, *extra_validators):
     schema = cv.Schema(schema).extend(
@@ -226,12 +231,15 @@ async def pulse_effect_to_code(config, effect_id):
         cv.Optional(
             CONF_UPDATE_INTERVAL, default="10s"
         ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_SEED): validate_seed,
     },
 )
 async def random_effect_to_code(config, effect_id):
     effect = cg.new_Pvariable(effect_id, config[CONF_NAME])
     cg.add(effect.set_transition_length(config[CONF_TRANSITION_LENGTH]))
     cg.add(effect.set_update_interval(config[CONF_UPDATE_INTERVAL]))
+    if CONF_SEED in config:
+        cg.add(effect.set_seed(config[CONF_SEED]))
     return effect
 
 
@@ -327,12 +335,15 @@ async def strobe_effect_to_code(config, effect_id):
     {
         cv.Optional(CONF_ALPHA, default=0.95): cv.percentage,
         cv.Optional(CONF_INTENSITY, default=0.015): cv.percentage,
+        cv.Optional(CONF_SEED): validate_seed,
     },
 )
 async def flicker_effect_to_code(config, effect_id):
     var = cg.new_Pvariable(effect_id, config[CONF_NAME])
     cg.add(var.set_alpha(config[CONF_ALPHA]))
     cg.add(var.set_intensity(config[CONF_INTENSITY]))
+    if CONF_SEED in config:
+        cg.add(var.set_seed(config[CONF_SEED]))
     return var
 
 
@@ -398,6 +409,7 @@ async def addressable_rainbow_effect_to_code(config, effect_id):
             CONF_ADD_LED_INTERVAL, default="0.1s"
         ): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_REVERSE, default=False): cv.boolean,
+        cv.Optional(CONF_SEED): validate_seed,
     },
 )
 async def addressable_color_wipe_effect_to_code(config, effect_id):
@@ -419,6 +431,8 @@ async def addressable_color_wipe_effect_to_code(config, effect_id):
             )
         )
     cg.add(var.set_colors(colors))
+    if CONF_SEED in config:
+        cg.add(var.set_seed(config[CONF_SEED]))
     return var
 
 
@@ -449,12 +463,15 @@ async def addressable_scan_effect_to_code(config, effect_id):
         cv.Optional(
             CONF_PROGRESS_INTERVAL, default="4ms"
         ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_SEED): validate_seed,
     },
 )
 async def addressable_twinkle_effect_to_code(config, effect_id):
     var = cg.new_Pvariable(effect_id, config[CONF_NAME])
     cg.add(var.set_twinkle_probability(config[CONF_TWINKLE_PROBABILITY]))
     cg.add(var.set_progress_interval(config[CONF_PROGRESS_INTERVAL]))
+    if CONF_SEED in config:
+        cg.add(var.set_seed(config[CONF_SEED]))
     return var
 
 
@@ -467,12 +484,15 @@ async def addressable_twinkle_effect_to_code(config, effect_id):
         cv.Optional(
             CONF_PROGRESS_INTERVAL, default="32ms"
         ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_SEED): validate_seed,
     },
 )
 async def addressable_random_twinkle_effect_to_code(config, effect_id):
     var = cg.new_Pvariable(effect_id, config[CONF_NAME])
     cg.add(var.set_twinkle_probability(config[CONF_TWINKLE_PROBABILITY]))
     cg.add(var.set_progress_interval(config[CONF_PROGRESS_INTERVAL]))
+    if CONF_SEED in config:
+        cg.add(var.set_seed(config[CONF_SEED]))
     return var
 
 
@@ -487,6 +507,7 @@ async def addressable_random_twinkle_effect_to_code(config, effect_id):
         cv.Optional(CONF_SPARK_PROBABILITY, default="10%"): cv.percentage,
         cv.Optional(CONF_USE_RANDOM_COLOR, default=False): cv.boolean,
         cv.Optional(CONF_FADE_OUT_RATE, default=120): cv.uint8_t,
+        cv.Optional(CONF_SEED): validate_seed,
     },
 )
 async def addressable_fireworks_effect_to_code(config, effect_id):
@@ -495,6 +516,8 @@ async def addressable_fireworks_effect_to_code(config, effect_id):
     cg.add(var.set_spark_probability(config[CONF_SPARK_PROBABILITY]))
     cg.add(var.set_use_random_color(config[CONF_USE_RANDOM_COLOR]))
     cg.add(var.set_fade_out_rate(config[CONF_FADE_OUT_RATE]))
+    if CONF_SEED in config:
+        cg.add(var.set_seed(config[CONF_SEED]))
     return var
 
 
@@ -507,12 +530,15 @@ async def addressable_fireworks_effect_to_code(config, effect_id):
             CONF_UPDATE_INTERVAL, default="16ms"
         ): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_INTENSITY, default="5%"): cv.percentage,
+        cv.Optional(CONF_SEED): validate_seed,
     },
 )
 async def addressable_flicker_effect_to_code(config, effect_id):
     var = cg.new_Pvariable(effect_id, config[CONF_NAME])
     cg.add(var.set_update_interval(config[CONF_UPDATE_INTERVAL]))
     cg.add(var.set_intensity(config[CONF_INTENSITY]))
+    if CONF_SEED in config:
+        cg.add(var.set_seed(config[CONF_SEED]))
     return var
 
 
@@ -1,5 +1,6 @@
 #include "esp_color_correction.h"
 #include "light_color_values.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -23,5 +24,12 @@ void ESPColorCorrection::calculate_gamma_table(float gamma) {
   }
 }
 
+void ESPColorCorrection::load_gamma_table(const uint8_t *table) {
+  for (uint16_t i = 0; i < 256; i++) {
+    this->gamma_table_[i] = progmem_read_byte(&table[i]);
+    this->gamma_reverse_table_[i] = progmem_read_byte(&table[256 + i]);
+  }
+}
+
 }  // namespace light
 }  // namespace esphome
@@ -7,12 +7,34 @@ namespace light {
 
 class ESPColorCorrection {
  public:
-  ESPColorCorrection() : max_brightness_(255, 255, 255, 255) {}
-  void set_max_brightness(const Color &max_brightness) { this->max_brightness_ = max_brightness; }
-  void set_local_brightness(uint8_t local_brightness) { this->local_brightness_ = local_brightness; }
+  ESPColorCorrection() : max_brightness_(255, 255, 255, 255) {
+    for (uint8_t channel = 0; channel < 4; channel++)
+      this->max_brightness_reciprocal_[channel] = reciprocal_(255);
+  }
+  void set_max_brightness(const Color &max_brightness) {
+    this->max_brightness_ = max_brightness;
+    this->uniform_max_brightness_ = max_brightness.red == max_brightness.green &&
+                                    max_brightness.red == max_brightness.blue &&
+                                    max_brightness.red == max_brightness.white;
+    for (uint8_t channel = 0; channel < 4; channel++)
+      this->max_brightness_reciprocal_[channel] = reciprocal_(max_brightness.raw[channel]);
+  }
+  void set_local_brightness(uint8_t local_brightness) {
+    if (local_brightness == this->local_brightness_)
+      return;
+    this->local_brightness_ = local_brightness;
+    this->local_brightness_reciprocal_ = reciprocal_(local_brightness);
+  }
   void calculate_gamma_table(float gamma);
+  /// Load gamma tables generated at compile time: 256 forward entries followed by 256 reverse entries, in PROGMEM.
+  void load_gamma_table(const uint8_t *table);
   inline Color color_correct(Color color) const ESPHOME_ALWAYS_INLINE {
     // corrected = (uncorrected * max_brightness * local_brightness) ^ gamma
+    if (this->uniform_max_brightness_) {
+      const Color scaled = scale8_(scale8_(color, this->max_brightness_.red), this->local_brightness_);
+      return Color(this->gamma_table_[scaled.red], this->gamma_table_[scaled.green], this->gamma_table_[scaled.blue],
+                   this->gamma_table_[scaled.white]);
+    }
     return Color(this->color_correct_red(color.red), this->color_correct_green(color.green),
                  this->color_correct_blue(color.blue), this->color_correct_white(color.white));
   }
@@ -37,40 +59,78 @@ class ESPColorCorrection {
     return Color(this->color_uncorrect_red(color.red), this->color_uncorrect_green(color.green),
                  this->color_uncorrect_blue(color.blue), this->color_uncorrect_white(color.white));
   }
-  inline uint8_t color_uncorrect_red(uint8_t red) const ESPHOME_ALWAYS_INLINE {
-    if (this->max_brightness_.red == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[red] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.red) * 255UL) / this->local_brightness_;
-    return res;
-  }
+  inline uint8_t color_uncorrect_red(uint8_t red) const ESPHOME_ALWAYS_INLINE { return this->color_uncorrect_(red, 0); }
   inline uint8_t color_uncorrect_green(uint8_t green) const ESPHOME_ALWAYS_INLINE {
-    if (this->max_brightness_.green == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[green] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.green) * 255UL) / this->local_brightness_;
-    return res;
+    return this->color_uncorrect_(green, 1);
   }
   inline uint8_t color_uncorrect_blue(uint8_t blue) const ESPHOME_ALWAYS_INLINE {
-    if (this->max_brightness_.blue == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[blue] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.blue) * 255UL) / this->local_brightness_;
-    return res;
+    return this->color_uncorrect_(blue, 2);
   }
   inline uint8_t color_uncorrect_white(uint8_t white) const ESPHOME_ALWAYS_INLINE {
-    if (this->max_brightness_.white == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[white] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.white) * 255UL) / this->local_brightness_;
-    return res;
+    return this->color_uncorrect_(white, 3);
   }
 
  protected:
+  /// n / divisor as (n * multiplier + increment) >> shift, all in 32 bits: the ESP8266 has no hardware divider, and
+  /// no instruction for the upper half of a 32x32 bit product either.
+  struct Reciprocal {
+    uint32_t multiplier;
+    uint32_t increment;
+    uint8_t shift;
+  };
+  /** The reciprocal of divisor for any n below 2^16, or all 0 for a divisor of 0 so everything divided by it comes out
+   * as 0.
+   *
+   * Robison's N-bit multiply-add division: with shift = 16 + floor(log2(divisor)), floor(2^shift / divisor) is at most
+   * 2^16. Rounded up, it divides exactly when the rounding adds at most 2^(shift - 16) to 2^shift; otherwise the
+   * rounded down multiplier does, applied to n + 1.
+   */
+  static Reciprocal reciprocal_(uint8_t divisor) {
+    if (divisor == 0)
+      return {0, 0, 0};
+    uint8_t log2 = 0;
+    while ((2u << log2) <= divisor)
+      log2++;
+    const uint8_t shift = 16 + log2;
+    const uint32_t down = (1UL << shift) / divisor;
+    if (down * divisor == (1UL << shift))
+      return {down, 0, shift};
+    if ((down + 1) * divisor - (1UL << shift) <= (1UL << log2))
+      return {down + 1, 0, shift};
+    return {down, down, shift};
+  }
+  /// esp_scale8() of all four channels at once, as two 16-bit lanes of a 32-bit word each: a channel times scale + 1
+  /// is at most 255 * 256, so no lane carries into the next.
+  static Color scale8_(Color color, uint8_t scale) ESPHOME_ALWAYS_INLINE {
+    const uint32_t factor = uint32_t(scale) + 1;
+    Color scaled;
+    scaled.raw_32 = ((((color.raw_32 & 0x00FF00FFu) * factor) >> 8) & 0x00FF00FFu) |
+                    ((((color.raw_32 >> 8) & 0x00FF00FFu) * factor) & 0xFF00FF00u);
+    return scaled;
+  }
+  static uint32_t divide_(uint32_t n, const Reciprocal &reciprocal) ESPHOME_ALWAYS_INLINE {
+    return (n * reciprocal.multiplier + reciprocal.increment) >> reciprocal.shift;
+  }
+  inline uint8_t color_uncorrect_(uint8_t value, uint8_t channel) const ESPHOME_ALWAYS_INLINE {
+    // uncorrected = corrected^(1/gamma) / (max_brightness * local_brightness), with both divisions done as
+    // multiplications because the ESP8266 has no hardware divider. Kept to 8 bits like the divisions always were.
+    const uint32_t uncorrected = this->gamma_reverse_table_[value] * 255UL;
+    const uint32_t scaled = divide_(uncorrected, this->max_brightness_reciprocal_[channel]) * 255UL;
+    if (scaled > 0xFFFF) {
+      // brighter than the max brightness allows, only for a pixel written around the correction
+      return this->local_brightness_ == 0 ? 0 : scaled / this->local_brightness_;
+    }
+    return divide_(scaled, this->local_brightness_reciprocal_);
+  }
+
   uint8_t gamma_table_[256];
   uint8_t gamma_reverse_table_[256];
   Color max_brightness_;
+  /// The same max brightness in every channel, so color_correct() can scale all of them at once.
+  bool uniform_max_brightness_{true};
   uint8_t local_brightness_{255};
+  Reciprocal max_brightness_reciprocal_[4];
+  Reciprocal local_brightness_reciprocal_{reciprocal_(255)};
 };
 
 }  // namespace light
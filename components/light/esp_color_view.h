@@ -53,14 +53,36 @@ class ESPColorView : public ESPColorSettable {
     this->set_hsv(rhs);
     return *this;
   }
-  void set(const Color &color) override { this->set_rgbw(color.r, color.g, color.b, color.w); }
-  void set_red(uint8_t red) override { *this->red_ = this->color_correction_->color_correct_red(red); }
-  void set_green(uint8_t green) override { *this->green_ = this->color_correction_->color_correct_green(green); }
-  void set_blue(uint8_t blue) override { *this->blue_ = this->color_correction_->color_correct_blue(blue); }
+  void set(const Color &color) override {
+    const bool was_lit = this->is_lit_();
+    *this->red_ = this->color_correction_->color_correct_red(color.r);
+    *this->green_ = this->color_correction_->color_correct_green(color.g);
+    *this->blue_ = this->color_correction_->color_correct_blue(color.b);
+    if (this->white_ != nullptr)
+      *this->white_ = this->color_correction_->color_correct_white(color.w);
+    this->count_lit_(was_lit);
+  }
+  void set_red(uint8_t red) override {
+    const bool was_lit = this->is_lit_();
+    *this->red_ = this->color_correction_->color_correct_red(red);
+    this->count_lit_(was_lit);
+  }
+  void set_green(uint8_t green) override {
+    const bool was_lit = this->is_lit_();
+    *this->green_ = this->color_correction_->color_correct_green(green);
+    this->count_lit_(was_lit);
+  }
+  void set_blue(uint8_t blue) override {
+    const bool was_lit = this->is_lit_();
+    *this->blue_ = this->color_correction_->color_correct_blue(blue);
+    this->count_lit_(was_lit);
+  }
   void set_white(uint8_t white) override {
     if (this->white_ == nullptr)
       return;
+    const bool was_lit = this->is_lit_();
     *this->white_ = this->color_correction_->color_correct_white(white);
+    this->count_lit_(was_lit);
   }
   void set_effect_data(uint8_t effect_data) override {
     if (this->effect_data_ == nullptr)
@@ -88,6 +110,20 @@ class ESPColorView : public ESPColorSettable {
       return 0;
     return *this->white_;
   }
+  /// Get the color as stored in the output buffer, i.e. with color correction applied.
+  Color get_raw() const {
+    return Color(*this->red_, *this->green_, *this->blue_, this->white_ == nullptr ? 0 : *this->white_);
+  }
+  /// Store an already corrected color directly in the output buffer, e.g. one obtained from get_raw().
+  void set_raw(const Color &raw) {
+    const bool was_lit = this->is_lit_();
+    *this->red_ = raw.red;
+    *this->green_ = raw.green;
+    *this->blue_ = raw.blue;
+    if (this->white_ != nullptr)
+      *this->white_ = raw.white;
+    this->count_lit_(was_lit);
+  }
   uint8_t get_effect_data() const {
     if (this->effect_data_ == nullptr)
       return 0;
@@ -96,14 +132,23 @@ class ESPColorView : public ESPColorSettable {
   void raw_set_color_correction(const ESPColorCorrection *color_correction) {
     this->color_correction_ = color_correction;
   }
+  /// Keep this count of lit pixels up to date on every write, see AddressableLight::mark_shown_().
+  void raw_set_lit_count(int32_t *lit_count) { this->lit_count_ = lit_count; }
 
  protected:
+  bool is_lit_() const { return this->lit_count_ != nullptr && this->get_raw().raw_32 != 0; }
+  void count_lit_(bool was_lit) {
+    if (this->lit_count_ != nullptr)
+      *this->lit_count_ += int32_t(this->get_raw().raw_32 != 0) - int32_t(was_lit);
+  }
+
   uint8_t *const red_;
   uint8_t *const green_;
   uint8_t *const blue_;
   uint8_t *const white_;
   uint8_t *const effect_data_;
   const ESPColorCorrection *color_correction_;
+  int32_t *lit_count_{nullptr};
 };
 
 }  // namespace light
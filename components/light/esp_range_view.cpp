@@ -12,14 +12,38 @@ int32_t HOT interpret_index(int32_t index, int32_t size) {
 
 ESPColorView ESPRangeView::operator[](int32_t index) const {
   index = interpret_index(index, this->size()) + this->begin_;
-  return (*this->parent_)[index];
+  return this->parent_->view_(index);
 }
 ESPRangeIterator ESPRangeView::begin() { return {*this, this->begin_}; }
 ESPRangeIterator ESPRangeView::end() { return {*this, this->end_}; }
 
 void ESPRangeView::set(const Color &color) {
+  // every pixel gets the same value, so only apply the color correction once
+  const Color raw = this->parent_->correction_.color_correct(color);
   for (int32_t i = this->begin_; i < this->end_; i++) {
-    (*this->parent_)[i] = color;
+    this->parent_->view_(i).set_raw(raw);
+  }
+#ifdef USE_POWER_SUPPLY
+  // the whole strip is known now, including pixels written around the views
+  if (this->begin_ == 0 && this->end_ == this->parent_->size())
+    this->parent_->lit_count_ = raw.raw_32 != 0 ? this->end_ : 0;
+#endif
+}
+
+void ESPRangeView::set_ramp(const Color *colors, uint16_t position, uint16_t step) {
+  // a ramp wider than the table repeats colors, so only correct a color again when the next LED gets another one
+  const ESPColorCorrection &correction = this->parent_->correction_;
+  uint8_t index = position >> 8;
+  Color raw = correction.color_correct(colors[index]);
+  for (int32_t i = this->begin_; i < this->end_; i++) {
+    if ((position >> 8) != index) {
+      index = position >> 8;
+      raw = correction.color_correct(colors[index]);
+    }
+    ESPColorView view = this->parent_->view_(i);
+    raw.white = view.get_raw().white;
+    view.set_raw(raw);
+    position += step;
   }
 }
 
@@ -75,22 +99,22 @@ ESPRangeView &ESPRangeView::operator=(const ESPRangeView &rhs) {  // NOLINT
   if (rhs.begin_ == this->begin_)
     return *this;
 
+  // Both ranges share the same color correction, so copy the corrected values as-is instead of uncorrecting and
+  // correcting every pixel again. This is both faster and lossless.
   if (rhs.begin_ > this->begin_) {
     // Copy from left
     for (int32_t i = 0; i < this->size(); i++) {
-      (*this)[i].set(rhs[i].get());
+      (*this)[i].set_raw(rhs[i].get_raw());
     }
   } else {
     // Copy from right
     for (int32_t i = this->size() - 1; i >= 0; i--) {
-      (*this)[i].set(rhs[i].get());
+      (*this)[i].set_raw(rhs[i].get_raw());
     }
   }
 
   return *this;
 }
 
-ESPColorView ESPRangeIterator::operator*() const { return this->range_.parent_->get(this->i_); }
-
 }  // namespace light
 }  // namespace esphome
@@ -32,6 +32,10 @@ class ESPRangeView : public ESPColorSettable {
   void set_blue(uint8_t blue) override;
   void set_white(uint8_t white) override;
   void set_effect_data(uint8_t effect_data) override;
+  /** Set the red, green and blue channels of a ramp through a table of 256 colors, like a rainbow of hues: the first
+   * LED gets colors[position >> 8], and every next one is step further along. The white channel is left alone.
+   */
+  void set_ramp(const Color *colors, uint16_t position, uint16_t step);
 
   void fade_to_white(uint8_t amnt) override;
   void fade_to_black(uint8_t amnt) override;
@@ -28,8 +28,38 @@ static const LogString *color_mode_to_human(ColorMode color_mode) {
   return LOG_STR("");
 }
 
+static const LogString *float_field_to_human(uint8_t index) {
+  switch (index) {
+    case 0:
+      return LOG_STR("Brightness");
+    case 1:
+      return LOG_STR("Color brightness");
+    case 2:
+      return LOG_STR("Red");
+    case 3:
+      return LOG_STR("Green");
+    case 4:
+      return LOG_STR("Blue");
+    case 5:
+      return LOG_STR("White");
+    case 6:
+      return LOG_STR("Color temperature");
+    case 7:
+      return LOG_STR("Cold white");
+    default:
+      return LOG_STR("Warm white");
+  }
+}
+
+float LightCall::*const LightCall::FLOAT_FIELDS[9] = {
+    &LightCall::brightness_, &LightCall::color_brightness_, &LightCall::red_, &LightCall::green_, &LightCall::blue_,
+    &LightCall::white_, &LightCall::color_temperature_, &LightCall::cold_white_, &LightCall::warm_white_,
+};
+
 void LightCall::perform() {
   const char *name = this->parent_->get_name().c_str();
+  // wake the light's loop(), this call may start an effect or transition
+  this->parent_->idle_ = false;
   LightColorValues v = this->validate_();
 
   // determine if call is superfluous.  i.e., a second call when the light is still in a transition
@@ -46,7 +76,7 @@ void LightCall::perform() {
     if (this->has_effect_())
     {
       super = false;
-      ESP_LOGD("KAUF Transition Filter", "Want to set an effect @ index %ud", this->effect_);
+      ESP_LOGD("KAUF Transition Filter", "Want to set an effect @ index %" PRIu32, this->effect_);
     }
 
     // is color mode the same?
@@ -110,41 +140,42 @@ void LightCall::perform() {
   ESP_LOGV("KAUF Transition Filter","--------------------------done, going ahead with call");
 
 
-  if (this->publish_) {
+  const bool publish = this->get_publish_();
+  if (publish) {
     ESP_LOGD(TAG, "'%s' Setting:", name);
 
     // Only print color mode when it's being changed
     ColorMode current_color_mode = this->parent_->remote_values.get_color_mode();
-    if (this->color_mode_.value_or(current_color_mode) != current_color_mode) {
+    if (this->has_color_mode_() && this->color_mode_ != current_color_mode) {
       ESP_LOGD(TAG, "  Color mode: %s", LOG_STR_ARG(color_mode_to_human(v.get_color_mode())));
     }
 
     // Only print state when it's being changed
     bool current_state = this->parent_->remote_values.is_on();
-    if (this->state_.value_or(current_state) != current_state) {
+    if (this->has_state_() && this->state_ != current_state) {
       ESP_LOGD(TAG, "  State: %s", ONOFF(v.is_on()));
     }
 
-    if (this->brightness_.has_value()) {
+    if (this->has_brightness_()) {
       ESP_LOGD(TAG, "  Brightness: %.0f%%", v.get_brightness() * 100.0f);
     }
 
-    if (this->color_brightness_.has_value()) {
+    if (this->has_color_brightness_()) {
       ESP_LOGD(TAG, "  Color brightness: %.0f%%", v.get_color_brightness() * 100.0f);
     }
-    if (this->red_.has_value() || this->green_.has_value() || this->blue_.has_value()) {
+    if (this->has_red_() || this->has_green_() || this->has_blue_()) {
       ESP_LOGD(TAG, "  Red: %.0f%%, Green: %.0f%%, Blue: %.0f%%", v.get_red() * 100.0f, v.get_green() * 100.0f,
                v.get_blue() * 100.0f);
     }
 
-    if (this->white_.has_value()) {
+    if (this->has_white_()) {
       ESP_LOGD(TAG, "  White: %.0f%%", v.get_white() * 100.0f);
     }
-    if (this->color_temperature_.has_value()) {
+    if (this->has_color_temperature_()) {
       ESP_LOGD(TAG, "  Color temperature: %.1f mireds", v.get_color_temperature());
     }
 
-    if (this->cold_white_.has_value() || this->warm_white_.has_value()) {
+    if (this->has_cold_white_() || this->has_warm_white_()) {
       ESP_LOGD(TAG, "  Cold white: %.0f%%, warm white: %.0f%%", v.get_cold_white() * 100.0f,
                v.get_warm_white() * 100.0f);
     }
@@ -152,58 +183,57 @@ void LightCall::perform() {
 
   if (this->has_flash_()) {
     // FLASH
-    if (this->publish_) {
-      ESP_LOGD(TAG, "  Flash length: %.1fs", *this->flash_length_ / 1e3f);
+    if (publish) {
+      ESP_LOGD(TAG, "  Flash length: %.1fs", this->flash_length_ / 1e3f);
     }
 
-    this->parent_->start_flash_(v, *this->flash_length_, this->publish_);
+    this->parent_->start_flash_(v, this->flash_length_, publish);
   } else if (this->has_transition_()) {
     // TRANSITION
-    if (this->publish_) {
-      ESP_LOGD(TAG, "  Transition length: %.1fs", *this->transition_length_ / 1e3f);
+    if (publish) {
+      ESP_LOGD(TAG, "  Transition length: %.1fs", this->transition_length_ / 1e3f);
     }
 
     // Special case: Transition and effect can be set when turning off
     if (this->has_effect_()) {
-      if (this->publish_) {
+      if (publish) {
         ESP_LOGD(TAG, "  Effect: 'None'");
       }
       this->parent_->stop_effect_();
     }
 
-    this->parent_->start_transition_(v, *this->transition_length_, this->publish_);
+    this->parent_->start_transition_(v, this->transition_length_, publish);
 
   } else if (this->has_effect_()) {
     // EFFECT
-    auto effect = this->effect_;
     const char *effect_s;
-    if (effect == 0u) {
+    if (this->effect_ == 0u) {
       effect_s = "None";
     } else {
-      effect_s = this->parent_->effects_[*this->effect_ - 1]->get_name().c_str();
+      effect_s = this->parent_->effects_[this->effect_ - 1]->get_name().c_str();
     }
 
-    if (this->publish_) {
+    if (publish) {
       ESP_LOGD(TAG, "  Effect: '%s'", effect_s);
     }
 
-    this->parent_->start_effect_(*this->effect_);
+    this->parent_->start_effect_(this->effect_);
 
     // Also set light color values when starting an effect
     // For example to turn off the light
     this->parent_->set_immediately_(v, true);
   } else {
     // INSTANT CHANGE
-    this->parent_->set_immediately_(v, this->publish_);
+    this->parent_->set_immediately_(v, publish);
   }
 
   if (!this->has_transition_()) {
     this->parent_->target_state_reached_callback_.call();
   }
-  if (this->publish_) {
+  if (publish) {
     this->parent_->publish_state();
   }
-  if (this->save_) {
+  if (this->get_save_()) {
     this->parent_->save_remote_values_();
   }
 }
@@ -213,202 +243,195 @@ LightColorValues LightCall::validate_() {
   auto traits = this->parent_->get_traits();
 
   // Color mode check
-  if (this->color_mode_.has_value() && !traits.supports_color_mode(this->color_mode_.value())) {
+  if (this->has_color_mode_() && !traits.supports_color_mode(this->color_mode_)) {
     ESP_LOGW(TAG, "'%s' - This light does not support color mode %s!", name,
-             LOG_STR_ARG(color_mode_to_human(this->color_mode_.value())));
-    this->color_mode_.reset();
+             LOG_STR_ARG(color_mode_to_human(this->color_mode_)));
+    this->set_flag_(FLAG_HAS_COLOR_MODE, false);
   }
 
   // Ensure there is always a color mode set
-  if (!this->color_mode_.has_value()) {
-    this->color_mode_ = this->compute_color_mode_();
+  if (!this->has_color_mode_()) {
+    this->set_color_mode(this->compute_color_mode_());
   }
-  auto color_mode = *this->color_mode_;
+  auto color_mode = this->color_mode_;
 
   // Transform calls that use non-native parameters for the current mode.
   this->transform_parameters_();
 
   // Brightness exists check
-  if (this->brightness_.has_value() && *this->brightness_ > 0.0f && !(color_mode & ColorCapability::BRIGHTNESS)) {
+  if (this->has_brightness_() && this->brightness_ > 0.0f && !(color_mode & ColorCapability::BRIGHTNESS)) {
     ESP_LOGW(TAG, "'%s' - This light does not support setting brightness!", name);
-    this->brightness_.reset();
+    this->set_flag_(FLAG_HAS_BRIGHTNESS, false);
   }
 
   // Transition length possible check
-  if (this->transition_length_.has_value() && *this->transition_length_ != 0 &&
+  if (this->has_transition_() && this->transition_length_ != 0 &&
       !(color_mode & ColorCapability::BRIGHTNESS)) {
     ESP_LOGW(TAG, "'%s' - This light does not support transitions!", name);
-    this->transition_length_.reset();
+    this->set_flag_(FLAG_HAS_TRANSITION, false);
   }
 
   // Color brightness exists check
-  if (this->color_brightness_.has_value() && *this->color_brightness_ > 0.0f && !(color_mode & ColorCapability::RGB)) {
+  if (this->has_color_brightness_() && this->color_brightness_ > 0.0f && !(color_mode & ColorCapability::RGB)) {
     ESP_LOGW(TAG, "'%s' - This color mode does not support setting RGB brightness!", name);
-    this->color_brightness_.reset();
+    this->set_flag_(FLAG_HAS_COLOR_BRIGHTNESS, false);
   }
 
   // RGB exists check
-  if ((this->red_.has_value() && *this->red_ > 0.0f) || (this->green_.has_value() && *this->green_ > 0.0f) ||
-      (this->blue_.has_value() && *this->blue_ > 0.0f)) {
+  if ((this->has_red_() && this->red_ > 0.0f) || (this->has_green_() && this->green_ > 0.0f) ||
+      (this->has_blue_() && this->blue_ > 0.0f)) {
     if (!(color_mode & ColorCapability::RGB)) {
       ESP_LOGW(TAG, "'%s' - This color mode does not support setting RGB color!", name);
-      this->red_.reset();
-      this->green_.reset();
-      this->blue_.reset();
+      this->set_flag_(FLAG_HAS_RED, false);
+      this->set_flag_(FLAG_HAS_GREEN, false);
+      this->set_flag_(FLAG_HAS_BLUE, false);
     }
   }
 
   // White value exists check
-  if (this->white_.has_value() && *this->white_ > 0.0f &&
+  if (this->has_white_() && this->white_ > 0.0f &&
       !(color_mode & ColorCapability::WHITE || color_mode & ColorCapability::COLD_WARM_WHITE)) {
     ESP_LOGW(TAG, "'%s' - This color mode does not support setting white value!", name);
-    this->white_.reset();
+    this->set_flag_(FLAG_HAS_WHITE, false);
   }
 
   // Color temperature exists check
-  if (this->color_temperature_.has_value() &&
+  if (this->has_color_temperature_() &&
       !(color_mode & ColorCapability::COLOR_TEMPERATURE || color_mode & ColorCapability::COLD_WARM_WHITE)) {
     ESP_LOGW(TAG, "'%s' - This color mode does not support setting color temperature!", name);
-    this->color_temperature_.reset();
+    this->set_flag_(FLAG_HAS_COLOR_TEMPERATURE, false);
   }
 
   // Cold/warm white value exists check
-  if ((this->cold_white_.has_value() && *this->cold_white_ > 0.0f) ||
-      (this->warm_white_.has_value() && *this->warm_white_ > 0.0f)) {
+  if ((this->has_cold_white_() && this->cold_white_ > 0.0f) ||
+      (this->has_warm_white_() && this->warm_white_ > 0.0f)) {
     if (!(color_mode & ColorCapability::COLD_WARM_WHITE)) {
       ESP_LOGW(TAG, "'%s' - This color mode does not support setting cold/warm white value!", name);
-      this->cold_white_.reset();
-      this->warm_white_.reset();
+      this->set_flag_(FLAG_HAS_COLD_WHITE, false);
+      this->set_flag_(FLAG_HAS_WARM_WHITE, false);
     }
   }
 
-#define VALIDATE_RANGE_(name_, upper_name, min, max) \
-  if (name_##_.has_value()) { \
-    auto val = *name_##_; \
-    if (val < (min) || val > (max)) { \
-      ESP_LOGW(TAG, "'%s' - %s value %.2f is out of range [%.1f - %.1f]!", name, LOG_STR_LITERAL(upper_name), val, \
-               (min), (max)); \
-      name_##_ = clamp(val, (min), (max)); \
-    } \
-  }
-#define VALIDATE_RANGE(name, upper_name) VALIDATE_RANGE_(name, upper_name, 0.0f, 1.0f)
-
-  // Range checks
-  VALIDATE_RANGE(brightness, "Brightness")
-  VALIDATE_RANGE(color_brightness, "Color brightness")
-  VALIDATE_RANGE(red, "Red")
-  VALIDATE_RANGE(green, "Green")
-  VALIDATE_RANGE(blue, "Blue")
-  VALIDATE_RANGE(white, "White")
-  VALIDATE_RANGE(cold_white, "Cold white")
-  VALIDATE_RANGE(warm_white, "Warm white")
-  VALIDATE_RANGE_(color_temperature, "Color temperature", traits.get_min_mireds(), traits.get_max_mireds())
+  // Range checks, visiting only the float fields that are set
+  for (uint16_t fields = this->flags_ & FLOAT_FIELDS_MASK; fields != 0; fields &= fields - 1) {
+    const uint8_t bit = __builtin_ctz(fields);
+    const uint8_t index = bit - FLOAT_FIELDS_FIRST_BIT;
+    float &val = this->*FLOAT_FIELDS[index];
+    const bool mireds = (1 << bit) == FLAG_HAS_COLOR_TEMPERATURE;
+    const float min = mireds ? traits.get_min_mireds() : 0.0f;
+    const float max = mireds ? traits.get_max_mireds() : 1.0f;
+    if (val < min || val > max) {
+      ESP_LOGW(TAG, "'%s' - %s value %.2f is out of range [%.1f - %.1f]!", name,
+               LOG_STR_ARG(float_field_to_human(index)), val, min, max);
+      val = clamp(val, min, max);
+    }
+  }
 
   // Flag whether an explicit turn off was requested, in which case we'll also stop the effect.
-  bool explicit_turn_off_request = this->state_.has_value() && !*this->state_;
+  bool explicit_turn_off_request = this->has_state_() && !this->state_;
 
   // Turn off when brightness is set to zero, and reset brightness (so that it has nonzero brightness when turned on).
-  if (this->brightness_.has_value() && *this->brightness_ == 0.0f) {
-    this->state_ = optional<float>(false);
-    this->brightness_ = optional<float>(1.0f);
+  if (this->has_brightness_() && this->brightness_ == 0.0f) {
+    this->set_state(false);
+    this->set_brightness(1.0f);
   }
 
   // Set color brightness to 100% if currently zero and a color is set.
-  if (this->red_.has_value() || this->green_.has_value() || this->blue_.has_value()) {
-    if (!this->color_brightness_.has_value() && this->parent_->remote_values.get_color_brightness() == 0.0f)
-      this->color_brightness_ = optional<float>(1.0f);
+  if (this->has_red_() || this->has_green_() || this->has_blue_()) {
+    if (!this->has_color_brightness_() && this->parent_->remote_values.get_color_brightness() == 0.0f)
+      this->set_color_brightness(1.0f);
   }
 
   // Create color values for the light with this call applied.
   auto v = this->parent_->remote_values;
-  if (this->color_mode_.has_value())
-    v.set_color_mode(*this->color_mode_);
-  if (this->state_.has_value())
-    v.set_state(*this->state_);
-  if (this->brightness_.has_value())
-    v.set_brightness(*this->brightness_);
-  if (this->color_brightness_.has_value())
-    v.set_color_brightness(*this->color_brightness_);
-  if (this->red_.has_value())
-    v.set_red(*this->red_);
-  if (this->green_.has_value())
-    v.set_green(*this->green_);
-  if (this->blue_.has_value())
-    v.set_blue(*this->blue_);
-  if (this->white_.has_value())
-    v.set_white(*this->white_);
-  if (this->color_temperature_.has_value())
-    v.set_color_temperature(*this->color_temperature_);
-  if (this->cold_white_.has_value())
-    v.set_cold_white(*this->cold_white_);
-  if (this->warm_white_.has_value())
-    v.set_warm_white(*this->warm_white_);
+  if (this->has_color_mode_())
+    v.set_color_mode(this->color_mode_);
+  if (this->has_state_())
+    v.set_state(this->state_);
+  if (this->has_brightness_())
+    v.set_brightness(this->brightness_);
+  if (this->has_color_brightness_())
+    v.set_color_brightness(this->color_brightness_);
+  if (this->has_red_())
+    v.set_red(this->red_);
+  if (this->has_green_())
+    v.set_green(this->green_);
+  if (this->has_blue_())
+    v.set_blue(this->blue_);
+  if (this->has_white_())
+    v.set_white(this->white_);
+  if (this->has_color_temperature_())
+    v.set_color_temperature(this->color_temperature_);
+  if (this->has_cold_white_())
+    v.set_cold_white(this->cold_white_);
+  if (this->has_warm_white_())
+    v.set_warm_white(this->warm_white_);
 
   v.normalize_color();
 
   // Flash length check
-  if (this->has_flash_() && *this->flash_length_ == 0) {
+  if (this->has_flash_() && this->flash_length_ == 0) {
     ESP_LOGW(TAG, "'%s' - Flash length must be greater than zero!", name);
-    this->flash_length_.reset();
+    this->set_flag_(FLAG_HAS_FLASH, false);
   }
 
   // validate transition length/flash length/effect not used at the same time
   bool supports_transition = color_mode & ColorCapability::BRIGHTNESS;
 
   // If effect is already active, remove effect start
-  if (this->has_effect_() && *this->effect_ == this->parent_->active_effect_index_) {
-    this->effect_.reset();
+  if (this->has_effect_() && this->effect_ == this->parent_->active_effect_index_) {
+    this->set_flag_(FLAG_HAS_EFFECT, false);
   }
 
   // validate effect index
-  if (this->has_effect_() && *this->effect_ > this->parent_->effects_.size()) {
-    ESP_LOGW(TAG, "'%s' - Invalid effect index %" PRIu32 "!", name, *this->effect_);
-    this->effect_.reset();
+  if (this->has_effect_() && this->effect_ > this->parent_->effects_.size()) {
+    ESP_LOGW(TAG, "'%s' - Invalid effect index %" PRIu32 "!", name, this->effect_);
+    this->set_flag_(FLAG_HAS_EFFECT, false);
   }
 
   if (this->has_effect_() && (this->has_transition_() || this->has_flash_())) {
     ESP_LOGW(TAG, "'%s' - Effect cannot be used together with transition/flash!", name);
-    this->transition_length_.reset();
-    this->flash_length_.reset();
+    this->set_flag_(FLAG_HAS_TRANSITION, false);
+    this->set_flag_(FLAG_HAS_FLASH, false);
   }
 
   if (this->has_flash_() && this->has_transition_()) {
     ESP_LOGW(TAG, "'%s' - Flash cannot be used together with transition!", name);
-    this->transition_length_.reset();
+    this->set_flag_(FLAG_HAS_TRANSITION, false);
   }
 
-  if (!this->has_transition_() && !this->has_flash_() && (!this->has_effect_() || *this->effect_ == 0) &&
+  if (!this->has_transition_() && !this->has_flash_() && (!this->has_effect_() || this->effect_ == 0) &&
       supports_transition) {
     // nothing specified and light supports transitions, set default transition length
-    this->transition_length_ = this->parent_->default_transition_length_;
+    this->set_transition_length(this->parent_->default_transition_length_);
   }
 
-  if (this->transition_length_.value_or(0) == 0) {
+  if (!this->has_transition_() || this->transition_length_ == 0) {
     // 0 transition is interpreted as no transition (instant change)
-    this->transition_length_.reset();
+    this->set_flag_(FLAG_HAS_TRANSITION, false);
   }
 
   if (this->has_transition_() && !supports_transition) {
     ESP_LOGW(TAG, "'%s' - Light does not support transitions!", name);
-    this->transition_length_.reset();
+    this->set_flag_(FLAG_HAS_TRANSITION, false);
   }
 
   // If not a flash and turning the light off, then disable the light
   // Do not use light color values directly, so that effects can set 0% brightness
   // Reason: When user turns off the light in frontend, the effect should also stop
-  if (!this->has_flash_() && !this->state_.value_or(v.is_on())) {
+  if (!this->has_flash_() && !(this->has_state_() ? this->state_ : v.is_on())) {
     if (this->has_effect_()) {
       ESP_LOGW(TAG, "'%s' - Cannot start an effect when turning off!", name);
-      this->effect_.reset();
+      this->set_flag_(FLAG_HAS_EFFECT, false);
     } else if (this->parent_->active_effect_index_ != 0 && explicit_turn_off_request) {
       // Auto turn off effect
-      this->effect_ = 0;
+      this->set_effect(0);
     }
   }
 
   // Disable saving for flashes
   if (this->has_flash_())
-    this->save_ = false;
+    this->set_save(false);
 
   return v;
 }
@@ -421,24 +444,24 @@ void LightCall::transform_parameters_() {
   // - RGBWW lights with color_interlock=true, which also sets "brightness" and
   //   "color_temperature" (without color_interlock, CW/WW are set directly)
   // - Legacy Home Assistant (pre-colormode), which sets "white" and "color_temperature"
-  if (((this->white_.has_value() && *this->white_ > 0.0f) || this->color_temperature_.has_value()) &&  //
-      (*this->color_mode_ & ColorCapability::COLD_WARM_WHITE) &&                                       //
-      !(*this->color_mode_ & ColorCapability::WHITE) &&                                                //
-      !(*this->color_mode_ & ColorCapability::COLOR_TEMPERATURE) &&                                    //
+  if (((this->has_white_() && this->white_ > 0.0f) || this->has_color_temperature_()) &&  //
+      (this->color_mode_ & ColorCapability::COLD_WARM_WHITE) &&                           //
+      !(this->color_mode_ & ColorCapability::WHITE) &&                                    //
+      !(this->color_mode_ & ColorCapability::COLOR_TEMPERATURE) &&                        //
       traits.get_min_mireds() > 0.0f && traits.get_max_mireds() > 0.0f) {
     ESP_LOGD(TAG, "'%s' - Setting cold/warm white channels using white/color temperature values.",
              this->parent_->get_name().c_str());
-    if (this->color_temperature_.has_value()) {
-      const float color_temp = clamp(*this->color_temperature_, traits.get_min_mireds(), traits.get_max_mireds());
+    if (this->has_color_temperature_()) {
+      const float color_temp = clamp(this->color_temperature_, traits.get_min_mireds(), traits.get_max_mireds());
       const float ww_fraction =
           (color_temp - traits.get_min_mireds()) / (traits.get_max_mireds() - traits.get_min_mireds());
       const float cw_fraction = 1.0f - ww_fraction;
       const float max_cw_ww = std::max(ww_fraction, cw_fraction);
-      this->cold_white_ = gamma_uncorrect(cw_fraction / max_cw_ww, this->parent_->get_gamma_correct());
-      this->warm_white_ = gamma_uncorrect(ww_fraction / max_cw_ww, this->parent_->get_gamma_correct());
+      this->set_cold_white(gamma_uncorrect(cw_fraction / max_cw_ww, this->parent_->get_gamma_correct()));
+      this->set_warm_white(gamma_uncorrect(ww_fraction / max_cw_ww, this->parent_->get_gamma_correct()));
     }
-    if (this->white_.has_value()) {
-      this->brightness_ = *this->white_;
+    if (this->has_white_()) {
+      this->set_brightness(this->white_);
     }
   }
 }
@@ -456,7 +479,7 @@ ColorMode LightCall::compute_color_mode_() {
 
   // Don't change if the light is being turned off.
   ColorMode current_mode = this->parent_->remote_values.get_color_mode();
-  if (this->state_.has_value() && !*this->state_)
+  if (this->has_state_() && !this->state_)
     return current_mode;
 
   // If no color mode is specified, we try to guess the color mode. This is needed for backward compatibility to
@@ -489,12 +512,12 @@ ColorMode LightCall::compute_color_mode_() {
   return color_mode;
 }
 std::set<ColorMode> LightCall::get_suitable_color_modes_() {
-  bool has_white = this->white_.has_value() && *this->white_ > 0.0f;
-  bool has_ct = this->color_temperature_.has_value();
-  bool has_cwww = (this->cold_white_.has_value() && *this->cold_white_ > 0.0f) ||
-                  (this->warm_white_.has_value() && *this->warm_white_ > 0.0f);
-  bool has_rgb = (this->color_brightness_.has_value() && *this->color_brightness_ > 0.0f) ||
-                 (this->red_.has_value() || this->green_.has_value() || this->blue_.has_value());
+  bool has_white = this->has_white_() && this->white_ > 0.0f;
+  bool has_ct = this->has_color_temperature_();
+  bool has_cwww = (this->has_cold_white_() && this->cold_white_ > 0.0f) ||
+                  (this->has_warm_white_() && this->warm_white_ > 0.0f);
+  bool has_rgb = (this->has_color_brightness_() && this->color_brightness_ > 0.0f) ||
+                 (this->has_red_() || this->has_green_() || this->has_blue_());
 
 #define KEY(white, ct, cwww, rgb) ((white) << 0 | (ct) << 1 | (cwww) << 2 | (rgb) << 3)
 #define ENTRY(white, ct, cwww, rgb, ...) \
@@ -539,11 +562,14 @@ LightCall &LightCall::set_effect(const std::string &effect) {
     return *this;
   }
 
+  // Compare the hashes computed when the effects were created, and only confirm a match with a string compare.
+  // The effect index is persisted to flash, so the effects can't be reordered into a lookup table.
+  const uint32_t hash = effect_name_hash(effect.c_str());
   bool found = false;
   for (uint32_t i = 0; i < this->parent_->effects_.size(); i++) {
     LightEffect *e = this->parent_->effects_[i];
 
-    if (strcasecmp(effect.c_str(), e->get_name().c_str()) == 0) {
+    if (e->get_name_hash() == hash && strcasecmp(effect.c_str(), e->get_name().c_str()) == 0) {
       this->set_effect(i + 1);
       found = true;
       break;
@@ -569,7 +595,7 @@ LightCall &LightCall::from_light_color_values(const LightColorValues &values) {
   return *this;
 }
 ColorMode LightCall::get_active_color_mode_() {
-  return this->color_mode_.value_or(this->parent_->remote_values.get_color_mode());
+  return this->has_color_mode_() ? this->color_mode_ : this->parent_->remote_values.get_color_mode();
 }
 LightCall &LightCall::set_transition_length_if_supported(uint32_t transition_length) {
   if (this->get_active_color_mode_() & ColorCapability::BRIGHTNESS)
@@ -583,7 +609,7 @@ LightCall &LightCall::set_brightness_if_supported(float brightness) {
 }
 LightCall &LightCall::set_color_mode_if_supported(ColorMode color_mode) {
   if (this->parent_->get_traits().supports_color_mode(color_mode))
-    this->color_mode_ = color_mode;
+    this->set_color_mode(color_mode);
   return *this;
 }
 LightCall &LightCall::set_color_brightness_if_supported(float brightness) {
@@ -628,107 +654,146 @@ LightCall &LightCall::set_warm_white_if_supported(float warm_white) {
   return *this;
 }
 LightCall &LightCall::set_state(optional<bool> state) {
-  this->state_ = state;
+  if (state.has_value())
+    this->state_ = *state;
+  this->set_flag_(FLAG_HAS_STATE, state.has_value());
   return *this;
 }
 LightCall &LightCall::set_state(bool state) {
   this->state_ = state;
+  this->set_flag_(FLAG_HAS_STATE, true);
   return *this;
 }
 LightCall &LightCall::set_transition_length(optional<uint32_t> transition_length) {
-  this->transition_length_ = transition_length;
+  if (transition_length.has_value())
+    this->transition_length_ = *transition_length;
+  this->set_flag_(FLAG_HAS_TRANSITION, transition_length.has_value());
   return *this;
 }
 LightCall &LightCall::set_transition_length(uint32_t transition_length) {
   this->transition_length_ = transition_length;
+  this->set_flag_(FLAG_HAS_TRANSITION, true);
   return *this;
 }
 LightCall &LightCall::set_flash_length(optional<uint32_t> flash_length) {
-  this->flash_length_ = flash_length;
+  if (flash_length.has_value())
+    this->flash_length_ = *flash_length;
+  this->set_flag_(FLAG_HAS_FLASH, flash_length.has_value());
   return *this;
 }
 LightCall &LightCall::set_flash_length(uint32_t flash_length) {
   this->flash_length_ = flash_length;
+  this->set_flag_(FLAG_HAS_FLASH, true);
   return *this;
 }
 LightCall &LightCall::set_brightness(optional<float> brightness) {
-  this->brightness_ = brightness;
+  if (brightness.has_value())
+    this->brightness_ = *brightness;
+  this->set_flag_(FLAG_HAS_BRIGHTNESS, brightness.has_value());
   return *this;
 }
 LightCall &LightCall::set_brightness(float brightness) {
   this->brightness_ = brightness;
+  this->set_flag_(FLAG_HAS_BRIGHTNESS, true);
   return *this;
 }
 LightCall &LightCall::set_color_mode(optional<ColorMode> color_mode) {
-  this->color_mode_ = color_mode;
+  if (color_mode.has_value())
+    this->color_mode_ = *color_mode;
+  this->set_flag_(FLAG_HAS_COLOR_MODE, color_mode.has_value());
   return *this;
 }
 LightCall &LightCall::set_color_mode(ColorMode color_mode) {
   this->color_mode_ = color_mode;
+  this->set_flag_(FLAG_HAS_COLOR_MODE, true);
   return *this;
 }
 LightCall &LightCall::set_color_brightness(optional<float> brightness) {
-  this->color_brightness_ = brightness;
+  if (brightness.has_value())
+    this->color_brightness_ = *brightness;
+  this->set_flag_(FLAG_HAS_COLOR_BRIGHTNESS, brightness.has_value());
   return *this;
 }
 LightCall &LightCall::set_color_brightness(float brightness) {
   this->color_brightness_ = brightness;
+  this->set_flag_(FLAG_HAS_COLOR_BRIGHTNESS, true);
   return *this;
 }
 LightCall &LightCall::set_red(optional<float> red) {
-  this->red_ = red;
+  if (red.has_value())
+    this->red_ = *red;
+  this->set_flag_(FLAG_HAS_RED, red.has_value());
   return *this;
 }
 LightCall &LightCall::set_red(float red) {
   this->red_ = red;
+  this->set_flag_(FLAG_HAS_RED, true);
   return *this;
 }
 LightCall &LightCall::set_green(optional<float> green) {
-  this->green_ = green;
+  if (green.has_value())
+    this->green_ = *green;
+  this->set_flag_(FLAG_HAS_GREEN, green.has_value());
   return *this;
 }
 LightCall &LightCall::set_green(float green) {
   this->green_ = green;
+  this->set_flag_(FLAG_HAS_GREEN, true);
   return *this;
 }
 LightCall &LightCall::set_blue(optional<float> blue) {
-  this->blue_ = blue;
+  if (blue.has_value())
+    this->blue_ = *blue;
+  this->set_flag_(FLAG_HAS_BLUE, blue.has_value());
   return *this;
 }
 LightCall &LightCall::set_blue(float blue) {
   this->blue_ = blue;
+  this->set_flag_(FLAG_HAS_BLUE, true);
   return *this;
 }
 LightCall &LightCall::set_white(optional<float> white) {
-  this->white_ = white;
+  if (white.has_value())
+    this->white_ = *white;
+  this->set_flag_(FLAG_HAS_WHITE, white.has_value());
   return *this;
 }
 LightCall &LightCall::set_white(float white) {
   this->white_ = white;
+  this->set_flag_(FLAG_HAS_WHITE, true);
   return *this;
 }
 LightCall &LightCall::set_color_temperature(optional<float> color_temperature) {
-  this->color_temperature_ = color_temperature;
+  if (color_temperature.has_value())
+    this->color_temperature_ = *color_temperature;
+  this->set_flag_(FLAG_HAS_COLOR_TEMPERATURE, color_temperature.has_value());
   return *this;
 }
 LightCall &LightCall::set_color_temperature(float color_temperature) {
   this->color_temperature_ = color_temperature;
+  this->set_flag_(FLAG_HAS_COLOR_TEMPERATURE, true);
   return *this;
 }
 LightCall &LightCall::set_cold_white(optional<float> cold_white) {
-  this->cold_white_ = cold_white;
+  if (cold_white.has_value())
+    this->cold_white_ = *cold_white;
+  this->set_flag_(FLAG_HAS_COLD_WHITE, cold_white.has_value());
   return *this;
 }
 LightCall &LightCall::set_cold_white(float cold_white) {
   this->cold_white_ = cold_white;
+  this->set_flag_(FLAG_HAS_COLD_WHITE, true);
   return *this;
 }
 LightCall &LightCall::set_warm_white(optional<float> warm_white) {
-  this->warm_white_ = warm_white;
+  if (warm_white.has_value())
+    this->warm_white_ = *warm_white;
+  this->set_flag_(FLAG_HAS_WARM_WHITE, warm_white.has_value());
   return *this;
 }
 LightCall &LightCall::set_warm_white(float warm_white) {
   this->warm_white_ = warm_white;
+  this->set_flag_(FLAG_HAS_WARM_WHITE, true);
   return *this;
 }
 LightCall &LightCall::set_effect(optional<std::string> effect) {
@@ -738,18 +803,21 @@ LightCall &LightCall::set_effect(optional<std::string> effect) {
 }
 LightCall &LightCall::set_effect(uint32_t effect_number) {
   this->effect_ = effect_number;
+  this->set_flag_(FLAG_HAS_EFFECT, true);
   return *this;
 }
 LightCall &LightCall::set_effect(optional<uint32_t> effect_number) {
-  this->effect_ = effect_number;
+  if (effect_number.has_value())
+    this->effect_ = *effect_number;
+  this->set_flag_(FLAG_HAS_EFFECT, effect_number.has_value());
   return *this;
 }
 LightCall &LightCall::set_publish(bool publish) {
-  this->publish_ = publish;
+  this->set_flag_(FLAG_PUBLISH, publish);
   return *this;
 }
 LightCall &LightCall::set_save(bool save) {
-  this->save_ = save;
+  this->set_flag_(FLAG_SAVE, save);
   return *this;
 }
 LightCall &LightCall::set_rgb(float red, float green, float blue) {
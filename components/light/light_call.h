@@ -170,27 +170,75 @@ class LightCall {
   /// Some color modes also can be set using non-native parameters, transform those calls.
   void transform_parameters_();
 
-  bool has_transition_() { return this->transition_length_.has_value(); }
-  bool has_flash_() { return this->flash_length_.has_value(); }
-  bool has_effect_() { return this->effect_.has_value(); }
+  /// Which of the fields below have been set (and whether to publish/save), instead of an optional<> per field.
+  enum FieldFlags : uint16_t {
+    FLAG_HAS_STATE = 1 << 0,
+    FLAG_HAS_TRANSITION = 1 << 1,
+    FLAG_HAS_FLASH = 1 << 2,
+    FLAG_HAS_EFFECT = 1 << 3,
+    FLAG_HAS_COLOR_MODE = 1 << 4,
+    FLAG_HAS_BRIGHTNESS = 1 << 5,
+    FLAG_HAS_COLOR_BRIGHTNESS = 1 << 6,
+    FLAG_HAS_RED = 1 << 7,
+    FLAG_HAS_GREEN = 1 << 8,
+    FLAG_HAS_BLUE = 1 << 9,
+    FLAG_HAS_WHITE = 1 << 10,
+    FLAG_HAS_COLOR_TEMPERATURE = 1 << 11,
+    FLAG_HAS_COLD_WHITE = 1 << 12,
+    FLAG_HAS_WARM_WHITE = 1 << 13,
+    FLAG_PUBLISH = 1 << 14,
+    FLAG_SAVE = 1 << 15,
+  };
+
+  /// The float fields, in the order of their flags from FLAG_HAS_BRIGHTNESS to FLAG_HAS_WARM_WHITE.
+  static float LightCall::*const FLOAT_FIELDS[9];
+  static constexpr uint8_t FLOAT_FIELDS_FIRST_BIT = 5;
+  static constexpr uint16_t FLOAT_FIELDS_MASK = (FLAG_HAS_WARM_WHITE << 1) - FLAG_HAS_BRIGHTNESS;
+  static_assert(FLAG_HAS_BRIGHTNESS == 1 << FLOAT_FIELDS_FIRST_BIT, "FLOAT_FIELDS_FIRST_BIT is the brightness flag");
+
+  bool has_flag_(FieldFlags flag) const { return (this->flags_ & flag) != 0; }
+  void set_flag_(FieldFlags flag, bool value) {
+    if (value) {
+      this->flags_ |= flag;
+    } else {
+      this->flags_ &= ~flag;
+    }
+  }
+
+  bool has_state_() const { return this->has_flag_(FLAG_HAS_STATE); }
+  bool has_transition_() const { return this->has_flag_(FLAG_HAS_TRANSITION); }
+  bool has_flash_() const { return this->has_flag_(FLAG_HAS_FLASH); }
+  bool has_effect_() const { return this->has_flag_(FLAG_HAS_EFFECT); }
+  bool has_color_mode_() const { return this->has_flag_(FLAG_HAS_COLOR_MODE); }
+  bool has_brightness_() const { return this->has_flag_(FLAG_HAS_BRIGHTNESS); }
+  bool has_color_brightness_() const { return this->has_flag_(FLAG_HAS_COLOR_BRIGHTNESS); }
+  bool has_red_() const { return this->has_flag_(FLAG_HAS_RED); }
+  bool has_green_() const { return this->has_flag_(FLAG_HAS_GREEN); }
+  bool has_blue_() const { return this->has_flag_(FLAG_HAS_BLUE); }
+  bool has_white_() const { return this->has_flag_(FLAG_HAS_WHITE); }
+  bool has_color_temperature_() const { return this->has_flag_(FLAG_HAS_COLOR_TEMPERATURE); }
+  bool has_cold_white_() const { return this->has_flag_(FLAG_HAS_COLD_WHITE); }
+  bool has_warm_white_() const { return this->has_flag_(FLAG_HAS_WARM_WHITE); }
+  bool get_publish_() const { return this->has_flag_(FLAG_PUBLISH); }
+  bool get_save_() const { return this->has_flag_(FLAG_SAVE); }
 
   LightState *parent_;
-  optional<bool> state_;
-  optional<uint32_t> transition_length_;
-  optional<uint32_t> flash_length_;
-  optional<ColorMode> color_mode_;
-  optional<float> brightness_;
-  optional<float> color_brightness_;
-  optional<float> red_;
-  optional<float> green_;
-  optional<float> blue_;
-  optional<float> white_;
-  optional<float> color_temperature_;
-  optional<float> cold_white_;
-  optional<float> warm_white_;
-  optional<uint32_t> effect_;
-  bool publish_{true};
-  bool save_{true};
+  // Values are only meaningful if the corresponding flag is set.
+  float brightness_{};
+  float color_brightness_{};
+  float red_{};
+  float green_{};
+  float blue_{};
+  float white_{};
+  float color_temperature_{};
+  float cold_white_{};
+  float warm_white_{};
+  uint32_t transition_length_{};
+  uint32_t flash_length_{};
+  uint32_t effect_{};
+  ColorMode color_mode_{ColorMode::UNKNOWN};
+  bool state_{};
+  uint16_t flags_{FLAG_PUBLISH | FLAG_SAVE};
 };
 
 }  // namespace light
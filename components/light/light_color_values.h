@@ -89,18 +89,30 @@ class LightColorValues {
    * @return The linearly interpolated LightColorValues.
    */
   static LightColorValues lerp(const LightColorValues &start, const LightColorValues &end, float completion) {
-    LightColorValues v;
-    v.set_color_mode(end.color_mode_);
+    // Only interpolate the attributes used by the color mode of the end values, the others are taken from end as-is.
+    // With an unknown color mode every attribute is interpolated.
+    const ColorMode mode = end.color_mode_;
+    const bool all = mode == ColorMode::UNKNOWN;
+    LightColorValues v = end;
+    v.use_raw = false;
     v.set_state(esphome::lerp(completion, start.get_state(), end.get_state()));
-    v.set_brightness(esphome::lerp(completion, start.get_brightness(), end.get_brightness()));
-    v.set_color_brightness(esphome::lerp(completion, start.get_color_brightness(), end.get_color_brightness()));
-    v.set_red(esphome::lerp(completion, start.get_red(), end.get_red()));
-    v.set_green(esphome::lerp(completion, start.get_green(), end.get_green()));
-    v.set_blue(esphome::lerp(completion, start.get_blue(), end.get_blue()));
-    v.set_white(esphome::lerp(completion, start.get_white(), end.get_white()));
-    v.set_color_temperature(esphome::lerp(completion, start.get_color_temperature(), end.get_color_temperature()));
-    v.set_cold_white(esphome::lerp(completion, start.get_cold_white(), end.get_cold_white()));
-    v.set_warm_white(esphome::lerp(completion, start.get_warm_white(), end.get_warm_white()));
+    if (all || (mode & ColorCapability::BRIGHTNESS))
+      v.set_brightness(esphome::lerp(completion, start.get_brightness(), end.get_brightness()));
+    if (all || (mode & ColorCapability::RGB)) {
+      v.set_color_brightness(esphome::lerp(completion, start.get_color_brightness(), end.get_color_brightness()));
+      v.set_red(esphome::lerp(completion, start.get_red(), end.get_red()));
+      v.set_green(esphome::lerp(completion, start.get_green(), end.get_green()));
+      v.set_blue(esphome::lerp(completion, start.get_blue(), end.get_blue()));
+    }
+    // as_ct() also scales by white, so interpolate it for color temperature modes as well
+    if (all || (mode & ColorCapability::WHITE) || (mode & ColorCapability::COLOR_TEMPERATURE))
+      v.set_white(esphome::lerp(completion, start.get_white(), end.get_white()));
+    if (all || (mode & ColorCapability::COLOR_TEMPERATURE))
+      v.set_color_temperature(esphome::lerp(completion, start.get_color_temperature(), end.get_color_temperature()));
+    if (all || (mode & ColorCapability::COLD_WARM_WHITE)) {
+      v.set_cold_white(esphome::lerp(completion, start.get_cold_white(), end.get_cold_white()));
+      v.set_warm_white(esphome::lerp(completion, start.get_warm_white(), end.get_warm_white()));
+    }
     return v;
   }
 
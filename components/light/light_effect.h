@@ -1,17 +1,29 @@
 #pragma once
 
+#include <cctype>
 #include <utility>
 
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 
 namespace esphome {
 namespace light {
 
 class LightState;
 
+/// Case-insensitive FNV-1 hash of an effect name, so effects can be looked up by name without comparing strings.
+inline uint32_t effect_name_hash(const char *name) {
+  uint32_t hash = 2166136261UL;
+  for (; *name != '\0'; name++) {
+    hash *= 16777619UL;
+    hash ^= static_cast<uint8_t>(tolower(static_cast<unsigned char>(*name)));
+  }
+  return hash;
+}
+
 class LightEffect {
  public:
-  explicit LightEffect(std::string name) : name_(std::move(name)) {}
+  explicit LightEffect(std::string name) : name_(std::move(name)), name_hash_(effect_name_hash(this->name_.c_str())) {}
 
   /// Initialize this LightEffect. Will be called once after creation.
   virtual void start() {}
@@ -24,8 +36,28 @@ class LightEffect {
   /// Apply this effect. Use the provided state for starting transitions, ...
   virtual void apply() = 0;
 
+  /// Whether apply() has to be called at time now. Effects that only do work periodically can set their next
+  /// wake-up time with wake_at_(), and the LightState skips calling apply() until then.
+  bool is_due(uint32_t now) const { return !this->has_wake_time_ || int32_t(now - this->wake_time_) >= 0; }
+
+  /// Forget the wake-up time so that apply() is called right away. Called by the LightState when starting the effect.
+  void clear_wake_time() { this->has_wake_time_ = false; }
+
+  /** Seed the random number generator of this effect.
+   *
+   * With a fixed seed every start of the effect replays the same random sequence. 0 (the default) seeds from the
+   * hardware RNG instead.
+   */
+  void set_seed(uint32_t seed) { this->seed_ = seed; }
+
+  /// Restart the random sequence from the seed. Called by the LightState when starting the effect.
+  void reset_random() { this->rng_state_ = 0; }
+
   const std::string &get_name() { return this->name_; }
 
+  /// Case-insensitive hash of the name, see effect_name_hash().
+  uint32_t get_name_hash() const { return this->name_hash_; }
+
   /// Internal method called by the LightState when this light effect is registered in it.
   virtual void init() {}
 
@@ -35,8 +67,41 @@ class LightEffect {
   }
 
  protected:
+  /// Don't call apply() again until millis() reaches wake_time.
+  void wake_at_(uint32_t wake_time) {
+    this->wake_time_ = wake_time;
+    this->has_wake_time_ = true;
+  }
+
+  /// Draw a random number from the xorshift32 generator of this effect, which is a lot cheaper than the hardware RNG.
+  uint32_t random_uint32_() {
+    uint32_t x = this->rng_state_;
+    if (x == 0) {
+      x = this->seed_ != 0 ? this->seed_ : random_uint32();
+      if (x == 0)
+        x = 1;
+    }
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    this->rng_state_ = x;
+    return x;
+  }
+  /// Random float in [0, 1).
+  float random_float_() { return float(this->random_uint32_() >> 8) / 16777216.0f; }
+  /// Random float in [-1, 1), biased towards 0.
+  float random_cubic_float_() {
+    const float r = this->random_float_() * 2.0f - 1.0f;
+    return r * r * r;
+  }
+
   LightState *state_{nullptr};
   std::string name_;
+  uint32_t name_hash_;
+  uint32_t wake_time_{0};
+  bool has_wake_time_{false};
+  uint32_t seed_{0};
+  uint32_t rng_state_{0};
 };
 
 }  // namespace light
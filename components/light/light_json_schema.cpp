@@ -10,9 +10,9 @@ namespace light {
 
 void LightJSONSchema::dump_json(LightState &state, JsonObject root) {
   if (state.supports_effects())
-    root["effect"] = state.get_effect_name();
+    root["effect"] = state.get_effect_name().c_str();
 
-  auto values = state.remote_values;
+  const auto &values = state.remote_values;
   auto traits = state.get_output()->get_traits();
 
   switch (values.get_color_mode()) {
@@ -73,8 +73,22 @@ void LightJSONSchema::dump_json(LightState &state, JsonObject root) {
 }
 
 void LightJSONSchema::parse_color_json(LightState &state, LightCall &call, JsonObject root) {
-  if (root.containsKey("state")) {
-    auto val = parse_on_off(root["state"]);
+  JsonVariant white_value;
+  for (JsonPair kv : root) {
+    LightJSONSchema::parse_color_key(state, call, kv.key().c_str(), kv.value(), white_value);
+  }
+  if (!white_value.isNull()) {  // legacy API
+    call.set_white(white_value.as<float>() / 255.0f);
+  }
+}
+
+bool LightJSONSchema::parse_color_key(LightState &state, LightCall &call, const char *key, JsonVariant value,
+                                      JsonVariant &white_value) {
+  if (strcmp(key, "state") == 0) {
+    const char *state_str = value.as<const char *>();
+    if (state_str == nullptr)  // not a string, parse_on_off() can't take it
+      return true;
+    auto val = parse_on_off(state_str);
     switch (val) {
       case PARSE_ON:
         call.set_state(true);
@@ -88,74 +102,101 @@ void LightJSONSchema::parse_color_json(LightState &state, LightCall &call, JsonO
       case PARSE_NONE:
         break;
     }
+  } else if (strcmp(key, "brightness") == 0) {
+    call.set_brightness(value.as<float>() / 255.0f);
+  } else if (strcmp(key, "color") == 0) {
+    LightJSONSchema::parse_color_object(call, value.as<JsonObject>());
+  } else if (strcmp(key, "white_value") == 0) {
+    // legacy API, applied by the caller once all keys are seen so it overrides color.w like it always did.
+    white_value = value;
+  } else if (strcmp(key, "color_temp") == 0) {
+    call.set_color_temperature(value.as<float>());
+  } else {
+    return false;
   }
+  return true;
+}
 
-  if (root.containsKey("brightness")) {
-    call.set_brightness(float(root["brightness"]) / 255.0f);
-  }
-
-  if (root.containsKey("color")) {
-    JsonObject color = root["color"];
-    // HA also encodes brightness information in the r, g, b values, so extract that and set it as color brightness.
-    float max_rgb = 0.0f;
-    if (color.containsKey("r")) {
-      float r = float(color["r"]) / 255.0f;
-      max_rgb = fmaxf(max_rgb, r);
-      call.set_red(r);
-    }
-    if (color.containsKey("g")) {
-      float g = float(color["g"]) / 255.0f;
-      max_rgb = fmaxf(max_rgb, g);
-      call.set_green(g);
-    }
-    if (color.containsKey("b")) {
-      float b = float(color["b"]) / 255.0f;
-      max_rgb = fmaxf(max_rgb, b);
-      call.set_blue(b);
-    }
-    if (color.containsKey("r") || color.containsKey("g") || color.containsKey("b")) {
-      call.set_color_brightness(max_rgb);
-    }
-
-    if (color.containsKey("c")) {
-      call.set_cold_white(float(color["c"]) / 255.0f);
-    }
-    if (color.containsKey("w")) {
-      // the HA scheme is ambiguous here, the same key is used for white channel in RGBW and warm
-      // white channel in RGBWW.
-      if (color.containsKey("c")) {
-        call.set_warm_white(float(color["w"]) / 255.0f);
-      } else {
-        call.set_white(float(color["w"]) / 255.0f);
-      }
+void LightJSONSchema::parse_color_object(LightCall &call, JsonObject color) {
+  // HA also encodes brightness information in the r, g, b values, so extract that and set it as color brightness.
+  float max_rgb = 0.0f;
+  bool has_rgb = false;
+  bool has_cold_white = false;
+  bool has_white = false;
+  float white = 0.0f;
+
+  for (JsonPair kv : color) {
+    const char *key = kv.key().c_str();
+    // all keys of the color object are a single character
+    if (key[0] == '\0' || key[1] != '\0')
+      continue;
+
+    float val = kv.value().as<float>() / 255.0f;
+    switch (key[0]) {
+      case 'r':
+        call.set_red(val);
+        break;
+      case 'g':
+        call.set_green(val);
+        break;
+      case 'b':
+        call.set_blue(val);
+        break;
+      case 'c':
+        call.set_cold_white(val);
+        has_cold_white = true;
+        continue;
+      case 'w':
+        white = val;
+        has_white = true;
+        continue;
+      default:
+        continue;
     }
+    max_rgb = fmaxf(max_rgb, val);
+    has_rgb = true;
   }
 
-  if (root.containsKey("white_value")) {  // legacy API
-    call.set_white(float(root["white_value"]) / 255.0f);
+  if (has_rgb) {
+    call.set_color_brightness(max_rgb);
   }
 
-  if (root.containsKey("color_temp")) {
-    call.set_color_temperature(float(root["color_temp"]));
+  if (has_white) {
+    // the HA scheme is ambiguous here, the same key is used for white channel in RGBW and warm
+    // white channel in RGBWW.
+    if (has_cold_white) {
+      call.set_warm_white(white);
+    } else {
+      call.set_white(white);
+    }
   }
 }
 
 void LightJSONSchema::parse_json(LightState &state, LightCall &call, JsonObject root) {
-  LightJSONSchema::parse_color_json(state, call, root);
-
-  if (root.containsKey("flash")) {
-    auto length = uint32_t(float(root["flash"]) * 1000);
-    call.set_flash_length(length);
-  }
-
-  if (root.containsKey("transition")) {
-    auto length = uint32_t(float(root["transition"]) * 1000);
-    call.set_transition_length(length);
+  // Walk the document once and dispatch on each key, instead of probing every key of the schema with containsKey()
+  // and then looking it up a second time.
+  JsonVariant white_value;
+  for (JsonPair kv : root) {
+    const char *key = kv.key().c_str();
+    JsonVariant value = kv.value();
+
+    if (LightJSONSchema::parse_color_key(state, call, key, value, white_value))
+      continue;
+
+    if (strcmp(key, "flash") == 0) {
+      auto length = uint32_t(value.as<float>() * 1000);
+      call.set_flash_length(length);
+    } else if (strcmp(key, "transition") == 0) {
+      auto length = uint32_t(value.as<float>() * 1000);
+      call.set_transition_length(length);
+    } else if (strcmp(key, "effect") == 0) {
+      const char *effect = value.as<const char *>();
+      if (effect != nullptr)
+        call.set_effect(effect);
+    }
   }
-
-  if (root.containsKey("effect")) {
-    const char *effect = root["effect"];
-    call.set_effect(effect);
+  if (!white_value.isNull()) {  // legacy API
+    call.set_white(white_value.as<float>() / 255.0f);
   }
 }
 
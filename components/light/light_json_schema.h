@@ -20,6 +20,11 @@ class LightJSONSchema {
 
  protected:
   static void parse_color_json(LightState &state, LightCall &call, JsonObject root);
+  /// Apply a single color related key of the JSON root to the call, return false if the key isn't one of them.
+  static bool parse_color_key(LightState &state, LightCall &call, const char *key, JsonVariant value,
+                              JsonVariant &white_value);
+  /// Apply the nested "color" object to the call.
+  static void parse_color_object(LightCall &call, JsonObject color);
 };
 
 }  // namespace light
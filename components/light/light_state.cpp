@@ -1,13 +1,94 @@
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "light_state.h"
 #include "light_output.h"
 #include "transformers.h"
 
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <sys/time.h>
+
 namespace esphome {
 namespace light {
 
 static const char *const TAG = "light";
 
+// DDP flag for a 32 bit timecode after the regular 10 byte header, before the channel data
+static const uint8_t DDP_FLAG_TIMECODE = 0x10;
+static const uint8_t DDP_HEADER_SIZE = 10;
+static const uint8_t DDP_HEADER_SIZE_TIMECODE = 14;
+// seconds from the NTP epoch (1900) to the Unix epoch, and the earliest system clock taken as set (2019, like ESPTime)
+static const uint32_t NTP_UNIX_OFFSET = 2208988800UL;
+static const time_t SYSTEM_CLOCK_VALID = 1546300800;
+// timecodes further than this from the system clock (1/65536 s) aren't NTP time
+static const int32_t DDP_NTP_WINDOW = 5 * 65536;
+
+// E1.31 (sACN) data packets: root layer with the ACN packet identifier, framing layer, DMP layer, then DMX data
+static const uint16_t E131_PORT = 5568;
+static const uint8_t E131_ACN_ID[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
+static const uint32_t E131_VECTOR_ROOT_DATA = 0x04;
+static const uint32_t E131_VECTOR_FRAMING_DATA = 0x02;
+static const uint8_t E131_OPTION_PREVIEW = 0x80;
+static const uint8_t E131_OPTION_TERMINATED = 0x40;
+static const uint8_t E131_DATA_OFFSET = 126;
+
+// Art-Net ArtDmx packets: ID, opcode, protocol version, sequence, physical, port address, length, then DMX data
+static const uint16_t ARTNET_PORT = 6454;
+static const uint8_t ARTNET_ID[8] = {'A', 'r', 't', '-', 'N', 'e', 't', 0};
+static const uint16_t ARTNET_OP_DMX = 0x5000;
+static const uint8_t ARTNET_DATA_OFFSET = 18;
+
+static uint8_t ddp_header_size(const uint8_t *payload) {
+  return (payload[0] & DDP_FLAG_TIMECODE) ? DDP_HEADER_SIZE_TIMECODE : DDP_HEADER_SIZE;
+}
+
+// DDP data types: bits 5-3 are the pixel type (1 RGB, 3 RGBW), bits 2-0 the channel size (3 is 8 bit, 4 is 16 bit).
+static const uint8_t DDP_TYPE_RGB16 = 0x0C;
+static const uint8_t DDP_TYPE_RGBW8 = 0x1B;
+static const uint8_t DDP_TYPE_RGBW16 = 0x1C;
+// RGB + cold white + warm white has no DDP type, use the customer defined bit on top of RGBW.
+static const uint8_t DDP_TYPE_RGBWW8 = 0x9B;
+static const uint8_t DDP_TYPE_RGBWW16 = 0x9C;
+
+struct DDPPixelFormat {
+  ColorMode color_mode;
+  uint8_t channels;
+  uint8_t channel_size;
+};
+
+static DDPPixelFormat ddp_pixel_format(uint8_t data_type) {
+  switch (data_type) {
+    case DDP_TYPE_RGB16:
+      return {ColorMode::RGB, 3, 2};
+    case DDP_TYPE_RGBW8:
+      return {ColorMode::RGB_WHITE, 4, 1};
+    case DDP_TYPE_RGBW16:
+      return {ColorMode::RGB_WHITE, 4, 2};
+    case DDP_TYPE_RGBWW8:
+      return {ColorMode::RGB_COLD_WARM_WHITE, 5, 1};
+    case DDP_TYPE_RGBWW16:
+      return {ColorMode::RGB_COLD_WARM_WHITE, 5, 2};
+    default:
+      // 8 bit RGB (0x0B), and anything else is read as 8 bit RGB like before.
+      return {ColorMode::RGB, 3, 1};
+  }
+}
+
+#ifdef USE_LIGHT_LOOP_PROFILER
+// Time the enclosing block of loop() as the given stage, the bookkeeping itself is not counted.
+#define LIGHT_LOOP_PROFILE_BEGIN() \
+  const uint32_t loop_profile_start = this->loop_profile_.empty() ? 0 : arch_get_cpu_cycle_count()
+#define LIGHT_LOOP_PROFILE_END(stage) \
+  do { \
+    if (!this->loop_profile_.empty()) \
+      this->record_loop_stage_(stage, arch_get_cpu_cycle_count() - loop_profile_start); \
+  } while (false)
+#else
+#define LIGHT_LOOP_PROFILE_BEGIN()
+#define LIGHT_LOOP_PROFILE_END(stage)
+#endif
+
 LightState::LightState(LightOutput *output) : output_(output) {}
 
 LightTraits LightState::get_traits() { return this->output_->get_traits(); }
@@ -117,32 +198,73 @@ void LightState::dump_config() {
     ESP_LOGCONFIG(TAG, "  Min Mireds: %.1f", this->get_traits().get_min_mireds());
     ESP_LOGCONFIG(TAG, "  Max Mireds: %.1f", this->get_traits().get_max_mireds());
   }
+  if (this->e131_universe_ != 0) {
+    ESP_LOGCONFIG(TAG, "  E1.31 Universe: %u", this->e131_universe_);
+  }
+  if (this->use_artnet_) {
+    ESP_LOGCONFIG(TAG, "  Art-Net Universe: %u", this->artnet_universe_);
+  }
+  if (this->e131_universe_ != 0 || this->use_artnet_) {
+    ESP_LOGCONFIG(TAG, "  DMX Channels: %u-%u", this->dmx_start_channel_,
+                  this->dmx_start_channel_ + this->dmx_channels_ - 1);
+  }
+#ifdef USE_LIGHT_LOOP_PROFILER
+  if (!this->loop_profile_.empty()) {
+    ESP_LOGCONFIG(TAG, "  Loop Profiler: enabled");
+  }
+#endif
 }
 void LightState::loop() {
-  // Apply effect (if any)
+  // while idle, only a scheduled write or a changed aux light (checked by the main light) needs any work here.
+  // LightCall::perform() and set_use_wled() clear idle_ for everything else.
+  if (this->idle_ && !this->next_write_) {
+    if (this->output_->is_aux() || !(this->output_->warm_rgb->has_changed || this->output_->cold_rgb->has_changed))
+      return;
+  }
+  this->idle_ = false;
+
+  // Apply effect (if any), unless it asked not to be woken up yet
   auto *effect = this->get_active_effect_();
-  if (effect != nullptr) {
+  if (effect != nullptr && effect->is_due(millis())) {
+    LIGHT_LOOP_PROFILE_BEGIN();
     effect->apply();
+    LIGHT_LOOP_PROFILE_END(LOOP_STAGE_EFFECT);
   }
 
   // run wled / ddp functions if enabled
-  if ( this->use_wled_ ) {wled_apply();}
+  if ( this->use_wled_ ) {
+    LIGHT_LOOP_PROFILE_BEGIN();
+    wled_apply();
+    dmx_apply();
+    if (this->ddp_frames_count_ > 0) {
+      this->play_ddp_frames_();
+    }
+    LIGHT_LOOP_PROFILE_END(LOOP_STAGE_WLED);
+  }
 
+#ifdef USE_LIGHT_UDP
   // if not enabled but UPD is configured, stop UDP and reset bulb values
-  else if (udp_) {
+  else if (udp_ || e131_udp_ || artnet_udp_) {
 
-    // stop listening on udp port
+    // stop listening on udp ports
     ESP_LOGD("KAUF WLED", "Stopping UDP listening");
-    udp_->stop();
-    udp_.reset();
+    for (auto *udp : {&udp_, &e131_udp_, &artnet_udp_}) {
+      if (*udp) {
+        (*udp)->stop();
+        udp->reset();
+      }
+    }
+    this->ddp_frames_count_ = 0;
 
     // return bulb to home assistant set values instead of previous wled value
     this->current_values = this->remote_values;
     this->next_write_ = true;
    }
+#endif
 
   // Apply transformer (if any)
   if (this->transformer_ != nullptr) {
+    LIGHT_LOOP_PROFILE_BEGIN();
     auto values = this->transformer_->apply();
     this->is_transformer_active_ = true;
     if (values.has_value()) {
@@ -160,29 +282,122 @@ void LightState::loop() {
       this->transformer_ = nullptr;
       this->target_state_reached_callback_.call();
     }
+    LIGHT_LOOP_PROFILE_END(LOOP_STAGE_TRANSFORMER);
   }
 
   // check if aux lights have changed and refresh main light if so.
   if ( !this->output_->is_aux() ) {
+    LIGHT_LOOP_PROFILE_BEGIN();
     if ( this->output_->warm_rgb->has_changed || this->output_->cold_rgb->has_changed ) {
       ESP_LOGV("KAUF_OUTPUT","warm or cold rgb changed");
       this->output_->warm_rgb->has_changed = false;
       this->output_->cold_rgb->has_changed = false;
       this->next_write_ = true;
     }
+    LIGHT_LOOP_PROFILE_END(LOOP_STAGE_AUX);
   }
 
   // Write state to the light
   if (this->next_write_) {
+    LIGHT_LOOP_PROFILE_BEGIN();
     this->next_write_ = false;
     this->output_->write_state(this);
+    LIGHT_LOOP_PROFILE_END(LOOP_STAGE_WRITE);
+
+    // receive to output latency of the DDP frame just written
+    if (this->ddp_stats_.latency_pending) {
+      const uint32_t latency = micros() - this->ddp_stats_.rx_us;
+      this->ddp_stats_.latency_pending = false;
+      this->ddp_stats_.latency_us += (float(latency) - this->ddp_stats_.latency_us) / 16.0f;
+      if (latency > this->ddp_stats_.max_latency_us)
+        this->ddp_stats_.max_latency_us = latency;
+    }
   }
+
+  // nothing animating, listening or left to write, so skip all of the above until woken up again
+  bool idle = this->active_effect_index_ == 0 && this->transformer_ == nullptr && !this->use_wled_ && !this->next_write_;
+#ifdef USE_LIGHT_UDP
+  idle = idle && !this->udp_ && !this->e131_udp_ && !this->artnet_udp_;
+#endif
+  this->idle_ = idle;
+}
+
+#ifdef USE_LIGHT_LOOP_PROFILER
+void LightState::set_loop_profiler(bool enabled) {
+  this->loop_profile_.clear();
+  if (enabled) {
+    this->loop_profile_.resize(LOOP_STAGE_COUNT);
+  }
+  this->loop_profile_.shrink_to_fit();
+}
+
+void LightState::record_loop_stage_(LoopStage stage, uint32_t cycles) {
+  LoopStageProfile &profile = this->loop_profile_[stage];
+  profile.count++;
+  profile.total_cycles += cycles;
+  if (cycles > profile.max_cycles)
+    profile.max_cycles = cycles;
+
+  // bucket is floor(log2(cycles)), 0 and 1 cycles both land in the first one
+  uint8_t bucket = 0;
+  while (cycles > 1 && bucket < LOOP_PROFILE_BUCKETS - 1) {
+    cycles >>= 1;
+    bucket++;
+  }
+  profile.buckets[bucket]++;
+}
+
+float LightState::get_loop_profile_mean_cycles(LoopStage stage) const {
+  if (this->loop_profile_.empty())
+    return 0.0f;
+  const LoopStageProfile &profile = this->loop_profile_[stage];
+  if (profile.count == 0)
+    return 0.0f;
+  return float(profile.total_cycles) / float(profile.count);
+}
+
+void LightState::reset_loop_profile() {
+  for (auto &profile : this->loop_profile_)
+    profile = LoopStageProfile{};
+}
+#endif
+
+void LightState::dump_loop_profile() {
+#ifdef USE_LIGHT_LOOP_PROFILER
+  static const char *const STAGE_NAMES[LOOP_STAGE_COUNT] = {"effect", "wled", "transformer", "aux", "write"};
+
+  if (this->loop_profile_.empty()) {
+    ESP_LOGW(TAG, "'%s' has no loop profile, set loop_profiler: true on the light", this->get_name().c_str());
+    return;
+  }
+  ESP_LOGI(TAG, "'%s' loop profile (CPU cycles):", this->get_name().c_str());
+  for (uint8_t stage = 0; stage < LOOP_STAGE_COUNT; stage++) {
+    const LoopStageProfile &profile = this->loop_profile_[stage];
+    ESP_LOGI(TAG, "  %s: %" PRIu32 " runs, mean %.0f, max %" PRIu32, STAGE_NAMES[stage], profile.count,
+             this->get_loop_profile_mean_cycles(LoopStage(stage)), profile.max_cycles);
+    for (uint8_t bucket = 0; bucket < LOOP_PROFILE_BUCKETS; bucket++) {
+      if (profile.buckets[bucket] != 0) {
+        ESP_LOGI(TAG, "    >= 2^%u: %" PRIu32, bucket, profile.buckets[bucket]);
+      }
+    }
+  }
+#else
+  ESP_LOGW(TAG, "'%s' has no loop profile, set loop_profiler: true on the light", this->get_name().c_str());
+#endif
 }
 
 
 // KAUF - shell of this function came from the stock ESPHome WLED component.
 // We changed the port and added DDP functionality.
 void LightState::wled_apply() {
+#ifndef USE_LIGHT_UDP
+  // the UDP receiver is built on the ESP8266 Arduino WiFiUDP, other platforms (e.g. host builds) only get parse_frame_()
+  static bool warned = false;
+  if (!warned) {
+    ESP_LOGW("KAUF WLED", "DDP receiving is only supported on ESP8266");
+    warned = true;
+  }
+#else
 
   // Init UDP lazily
   if (!udp_) {
@@ -197,51 +412,61 @@ void LightState::wled_apply() {
 
   }
 
-  std::vector<uint8_t> payload;
+  std::vector<uint8_t> &payload = this->udp_packet_;
   while (uint16_t packet_size = udp_->parsePacket()) {
+    this->ddp_packet_rx_us_ = micros();
     payload.resize(packet_size);
 
     if (!udp_->read(&payload[0], payload.size())) {
       return;
     }
 
-    if (!this->parse_frame_(&payload[0], payload.size())) {
-      return;
+    const bool applied = this->parse_frame_(&payload[0], payload.size());
+    this->ddp_packet_rx_us_.reset();
+    if (!applied) {
+      continue;
     }
 
     // need at least 16 bytes to be able to forward anything.
-    // 10 for header, 3 this pixel's data, 3 to forward to next pixel.
-    if ( payload.size() < 16 ) {
-      return;
+    // 10 for header (14 with timecode), 3 this pixel's data, 3 to forward to next pixel.
+    // pixels with white channels or 16 bit channels take up more than 3 bytes.
+    const uint8_t header_size = ddp_header_size(&payload[0]);
+    const DDPPixelFormat format = ddp_pixel_format(payload[2]);
+    const uint8_t pixel_size = format.channels * format.channel_size;
+    const uint16_t data_start = header_size + pixel_size;
+    // nothing to forward (e.g. a leader's single pixel), read the next packet so none are left queued for a loop
+    if ( payload.size() < data_start + pixel_size ) {
+      continue;
     }
 
-    // get current ip address, quit if 254.  Not going to forward to 255.
+    // get current ip address, don't forward if 254.  Not going to forward to 255.
+    // whatever stops the forwarding, carry on with the next packet so none are left queued for a loop
     network::IPAddress addr = wifi::global_wifi_component->get_ip_addresses()[0];
     uint8_t addr4 = ip4_addr4_val(addr.ip_addr_);
 
     if ( addr4 >= 254 ) {
       ESP_LOGE("KAUF WLED", "DDP chaining force stopped at address *.254");
-      return;
+      continue;
     }
 
     // increment address so its on the next pixel (first forwarded pixel)
     addr += 1;
 
     // forward remaining ddp data.  split into 2 packets if more than one pixel to forward.
-    // payload size - 13 gives you total number of data bytes to forward (after subtracting header and first pixel)
-    // divide by 3 gives you number of pixels
+    // payload size - data_start gives you total number of data bytes to forward (after subtracting header and first pixel)
+    // divide by pixel size gives you number of pixels
     // divide by 2 gives you number for one of two packets.
     // handle odd total by subtracting packet2 from total to get packet1 instead of dividing by 2 again.
     // packet 2 length is calculated first so that its always the smaller (we don't want packet 1 to be zero is really the issue)
-    uint16_t packet2_length = ((payload.size()-13)/3)/2;
-    uint16_t packet1_length = ((payload.size()-13)/3)-packet2_length;
+    uint16_t packet2_length = ((payload.size()-data_start)/pixel_size)/2;
+    uint16_t packet1_length = ((payload.size()-data_start)/pixel_size)-packet2_length;
 
     // send first packet
     WiFiUDP udp2;
 
     if (!udp2.beginPacket(addr.str().c_str(), 4048)) {
       ESP_LOGE("KAUF WLED", "Error beginning first DDP packet!");
-      return;
+      continue;
     }
 
     udp2.write(payload[0]);                // flags, keep same
@@ -252,33 +477,36 @@ void LightState::wled_apply() {
     udp2.write(payload[5]);                // data offset, keep same.  Should always be 0 anyway.
     udp2.write(payload[6]);                // data offset, keep same.  Should always be 0 anyway.
     udp2.write(payload[7]);                // data offset, keep same.  Should always be 0 anyway.
-    udp2.write(0);                         // first byte of length always 0, doesn't matter since next pixel doesn't care.
-    udp2.write(10 + (packet1_length * 3)); // data length, add 10 for header
+    udp2.write((10 + (packet1_length * pixel_size)) >> 8);   // data length, add 10 for header
+    udp2.write((10 + (packet1_length * pixel_size)) & 0xFF); // next pixel doesn't care, but wider pixels go past 255
+    for (uint8_t i = DDP_HEADER_SIZE; i < header_size; i++) {
+      udp2.write(payload[i]);              // timecode, keep same so all bulbs present the frame at the same time
+    }
 
-    // write out payload data starting with byte 13 (4th RGB channel), and going for packet1_length * 3 (3 bytes per pixel).
-    for (uint16_t i = 13; i < ((packet1_length*3)+13); i++) {
+    // write out payload data starting with the second pixel, and going for packet1_length pixels.
+    for (uint16_t i = data_start; i < ((packet1_length*pixel_size)+data_start); i++) {
       udp2.write(payload[i]);
     }
 
     if (!udp2.endPacket()) {
       ESP_LOGE("KAUF WLED", "Error ending first DDP packet!");
-      return;
+      continue;
     }
+    this->ddp_stats_.bytes_forwarded += header_size + (packet1_length * pixel_size);
 
     // send second packet if needed
     if ( packet2_length == 0 ) {
-      return;
+      continue;
     }
 
     if ( addr4 + packet1_length + 1 >= 255 ) {
-      return;
-    } else {
-      addr += packet1_length;
+      continue;
     }
+    addr += packet1_length;
 
     if (!udp2.beginPacket(addr.str().c_str(), 4048)) {
       ESP_LOGE("KAUF WLED", "Error beginning second DDP packet!");
-      return;
+      continue;
     }
 
     udp2.write(payload[0]);                // flags, keep same
@@ -289,24 +517,269 @@ void LightState::wled_apply() {
     udp2.write(payload[5]);                // data offset, keep same.  Should always be 0 anyway.
     udp2.write(payload[6]);                // data offset, keep same.  Should always be 0 anyway.
     udp2.write(payload[7]);                // data offset, keep same.  Should always be 0 anyway.
-    udp2.write(0);                         // first byte of length always 0, doesn't matter since next pixel doesn't care.
-    udp2.write(10 + (packet2_length * 3)); // data length, add 10 for header
+    udp2.write((10 + (packet2_length * pixel_size)) >> 8);   // data length, add 10 for header
+    udp2.write((10 + (packet2_length * pixel_size)) & 0xFF); // next pixel doesn't care, but wider pixels go past 255
+    for (uint8_t i = DDP_HEADER_SIZE; i < header_size; i++) {
+      udp2.write(payload[i]);              // timecode, keep same so all bulbs present the frame at the same time
+    }
 
-    // write out all the payload data starting with byte 13 plus packet1_length*3 (RGB channel after first packet).
-    for (uint16_t i = 13+(packet1_length*3); i < payload.size(); i++) {
+    // write out all the payload data starting with the second pixel plus packet1_length pixels (pixel after first packet).
+    for (uint16_t i = data_start+(packet1_length*pixel_size); i < payload.size(); i++) {
       udp2.write(payload[i]);
     }
 
     if (!udp2.endPacket()) {
       ESP_LOGE("KAUF WLED", "Error ending second DDP packet!");
-      return;
+      continue;
+    }
+    this->ddp_stats_.bytes_forwarded += header_size + (packet2_length * pixel_size);
+
+  }
+#endif
+}
+
+void LightState::record_ddp_packet_(const uint8_t *payload) {
+  DDPStats &stats = this->ddp_stats_;
+  const uint32_t now = this->ddp_packet_rx_us_.value_or(micros());
+
+  // A stream that (re)starts after a pause begins a new jitter histogram, like the fps window. The pause itself isn't
+  // an arrival interval.
+  if (stats.packets == 0 || now - stats.last_arrival_us > DDP_STREAM_TIMEOUT_US) {
+    for (uint32_t &count : stats.jitter_buckets)
+      count = 0;
+    stats.jitter_window_start_us = now;
+    stats.stream_packets = 0;
+  }
+  // halve the histogram every second, so the percentiles follow the last few seconds of the stream
+  if (now - stats.jitter_window_start_us >= 1000000) {
+    for (uint32_t &count : stats.jitter_buckets)
+      count >>= 1;
+    stats.jitter_window_start_us = now;
+  }
+
+  // inter-arrival jitter, smoothed with gain 1/16 as in RFC 3550
+  if (stats.stream_packets > 0) {
+    const uint32_t interval = now - stats.last_arrival_us;
+    if (stats.stream_packets > 1) {
+      const uint32_t deviation =
+          interval > stats.last_interval_us ? interval - stats.last_interval_us : stats.last_interval_us - interval;
+      stats.jitter_us += (float(deviation) - stats.jitter_us) / 16.0f;
+
+      uint8_t bucket = 0;
+      for (uint32_t d = deviation; d > 1 && bucket < DDP_JITTER_BUCKETS - 1; d >>= 1)
+        bucket++;
+      stats.jitter_buckets[bucket]++;
     }
+    stats.last_interval_us = interval;
+  }
+  stats.last_arrival_us = now;
+  stats.packets++;
+  if (stats.stream_packets < 2)
+    stats.stream_packets++;
+
+  // sequence numbers count 1-15 and wrap, 0 means the sender doesn't use them
+  const uint8_t seq = payload[1] & 0x0F;
+  if (seq == 0 || stats.last_seq == 0) {
+    stats.last_seq = seq;
+    stats.behind_seq = 0;
+    return;
+  }
+  // only a step of 1-7 forward is new data, anything else is a duplicate or arrived late and isn't a loss
+  const uint8_t step = (seq + 15 - stats.last_seq) % 15;
+  if (step == 0)
+    return;
+  if (step > 7) {
+    // ... or the first packet after losing 7 or more. A second one behind that follows right after it is taken as
+    // such a loss, and counting continues from there.
+    if (stats.behind_seq != 0 && seq == stats.behind_seq % 15 + 1) {
+      stats.seq_gaps += stats.behind_step - 1;
+      stats.last_seq = seq;
+      stats.behind_seq = 0;
+    } else {
+      stats.behind_seq = seq;
+      stats.behind_step = step;
+    }
+    return;
+  }
+  stats.behind_seq = 0;
+  stats.seq_gaps += step - 1;
+  stats.last_seq = seq;
+}
+
+float LightState::get_ddp_fps() const {
+  // the window is only rolled over by incoming frames, so a stream that stopped reads as 0
+  if (millis() - this->ddp_stats_.window_start_ms > 2000)
+    return 0.0f;
+  return this->ddp_stats_.fps;
+}
+
+float LightState::get_ddp_jitter_percentile(float percentile) const {
+  // like the fps, a stream that stopped reads as 0
+  if (this->ddp_stats_.packets == 0 || micros() - this->ddp_stats_.last_arrival_us > DDP_STREAM_TIMEOUT_US)
+    return 0.0f;
+  uint32_t total = 0;
+  for (uint32_t count : this->ddp_stats_.jitter_buckets)
+    total += count;
+  if (total == 0)
+    return 0.0f;
+
+  const float target = percentile * total;
+  uint32_t cumulative = 0;
+  for (uint8_t bucket = 0; bucket < DDP_JITTER_BUCKETS; bucket++) {
+    cumulative += this->ddp_stats_.jitter_buckets[bucket];
+    if (cumulative >= target)
+      return float(2u << bucket) / 1000.0f;
+  }
+  return float(2u << (DDP_JITTER_BUCKETS - 1)) / 1000.0f;
+}
+
+void LightState::dmx_apply() {
+#ifdef USE_LIGHT_UDP
+  std::vector<uint8_t> &payload = this->udp_packet_;
+
+  // Joining a multicast group needs the station's address, and lwIP forgets the membership when WiFi drops. So only
+  // bind while connected, close the socket on a disconnect and join again once reconnected.
+  if (this->e131_udp_ && !WiFi.isConnected()) {
+    ESP_LOGD("KAUF WLED", "WiFi disconnected, stopping E1.31 listening");
+    this->e131_udp_->stop();
+    this->e131_udp_.reset();
+  }
+
+  // retry a failed bind at most once a second
+  const uint32_t now = millis();
+  const bool may_bind = now - this->dmx_last_bind_ms_ >= 1000 || this->dmx_last_bind_ms_ == 0;
+
+  if (this->e131_universe_ != 0 && !this->e131_udp_ && may_bind && WiFi.isConnected()) {
+    // Each universe has its own multicast group, unicast to the port is received as well.
+    this->dmx_last_bind_ms_ = now;
+    this->e131_udp_ = make_unique<WiFiUDP>();
+    ESP_LOGD("KAUF WLED", "Starting E1.31 listening on universe %u", this->e131_universe_);
+    IPAddress group(239, 255, this->e131_universe_ >> 8, this->e131_universe_ & 0xFF);
+    if (!this->e131_udp_->beginMulticast(WiFi.localIP(), group, E131_PORT)) {
+      ESP_LOGE(TAG, "Cannot bind E1.31 to port %u, retrying.", E131_PORT);
+      this->e131_udp_.reset();
+    }
+  }
+
+  if (this->e131_udp_) {
+    while (uint16_t packet_size = this->e131_udp_->parsePacket()) {
+      this->ddp_packet_rx_us_ = micros();
+      payload.resize(packet_size);
+      if (!this->e131_udp_->read(&payload[0], payload.size())) {
+        break;
+      }
+      this->parse_e131_(&payload[0], payload.size());
+      this->ddp_packet_rx_us_.reset();
+    }
+  }
+
+  if (this->use_artnet_ && !this->artnet_udp_ && may_bind) {
+    this->dmx_last_bind_ms_ = now;
+    this->artnet_udp_ = make_unique<WiFiUDP>();
+    ESP_LOGD("KAUF WLED", "Starting Art-Net listening on universe %u", this->artnet_universe_);
+    if (!this->artnet_udp_->begin(ARTNET_PORT)) {
+      ESP_LOGE(TAG, "Cannot bind Art-Net to port %u, retrying.", ARTNET_PORT);
+      this->artnet_udp_.reset();
+    }
+  }
+
+  if (this->artnet_udp_) {
+    while (uint16_t packet_size = this->artnet_udp_->parsePacket()) {
+      this->ddp_packet_rx_us_ = micros();
+      payload.resize(packet_size);
+      if (!this->artnet_udp_->read(&payload[0], payload.size())) {
+        break;
+      }
+      this->parse_artnet_(&payload[0], payload.size());
+      this->ddp_packet_rx_us_.reset();
+    }
+  }
+#endif
+}
+
+bool LightState::parse_e131_(const uint8_t *payload, uint16_t size) {
+  if (size < E131_DATA_OFFSET || memcmp(payload + 4, E131_ACN_ID, sizeof(E131_ACN_ID)) != 0) {
+    return false;
+  }
+
+  // only DMX data, not sync or universe discovery packets
+  if (encode_uint32(payload[18], payload[19], payload[20], payload[21]) != E131_VECTOR_ROOT_DATA ||
+      encode_uint32(payload[40], payload[41], payload[42], payload[43]) != E131_VECTOR_FRAMING_DATA) {
+    return false;
+  }
+
+  // skip preview data and the packet a source sends when it stops
+  if (payload[112] & (E131_OPTION_PREVIEW | E131_OPTION_TERMINATED)) {
+    return false;
+  }
+
+  if (encode_uint16(payload[113], payload[114]) != this->e131_universe_) {
+    return false;
+  }
 
+  // start code 0 is channel levels, other start codes carry e.g. per channel priorities
+  if (payload[125] != 0) {
+    return false;
+  }
+
+  // property value count includes the start code
+  uint16_t length = encode_uint16(payload[123], payload[124]);
+  if (length == 0) {
+    return false;
+  }
+  length = std::min<uint16_t>(length - 1, size - E131_DATA_OFFSET);
+
+  return this->parse_dmx_(payload + E131_DATA_OFFSET, length);
+}
+
+bool LightState::parse_artnet_(const uint8_t *payload, uint16_t size) {
+  if (size < ARTNET_DATA_OFFSET || memcmp(payload, ARTNET_ID, sizeof(ARTNET_ID)) != 0) {
+    return false;
   }
+
+  // the opcode is little endian, unlike everything else in the packet
+  if (encode_uint16(payload[9], payload[8]) != ARTNET_OP_DMX) {
+    return false;
+  }
+
+  // 15 bit port address, net in the high byte and sub-net + universe in the low byte
+  if (encode_uint16(payload[15] & 0x7F, payload[14]) != this->artnet_universe_) {
+    return false;
+  }
+
+  const uint16_t length = std::min<uint16_t>(encode_uint16(payload[16], payload[17]), size - ARTNET_DATA_OFFSET);
+
+  return this->parse_dmx_(payload + ARTNET_DATA_OFFSET, length);
+}
+
+bool LightState::parse_dmx_(const uint8_t *dmx, uint16_t length) {
+  const uint16_t first = this->dmx_start_channel_ - 1;
+  if (length < first + this->dmx_channels_) {
+    return false;
+  }
+
+  float channels[DDP_MAX_CHANNELS] = {};
+  for (uint8_t i = 0; i < this->dmx_channels_; i++) {
+    channels[i] = (float)dmx[first + i]/255.0f;
+  }
+
+  ColorMode color_mode = ColorMode::RGB;
+  if (this->dmx_channels_ == 4) {
+    color_mode = ColorMode::RGB_WHITE;
+  } else if (this->dmx_channels_ == 5) {
+    color_mode = ColorMode::RGB_COLD_WARM_WHITE;
+  }
+
+  this->show_pixel_(color_mode, channels, {});
+  return true;
 }
 
 bool LightState::parse_frame_(const uint8_t *payload, uint16_t size) {
 
+  if (size >= 10) {
+    this->record_ddp_packet_(payload);
+  }
+
   if ( this->ddp_debug_ > 0) {
     if ( size < 10 ){
       ESP_LOGD("KAUF DDP Debug", "Invalid DDP packet received, too short (size=%d)", size);
@@ -329,6 +802,16 @@ bool LightState::parse_frame_(const uint8_t *payload, uint16_t size) {
     return false;
   }
 
+  const uint8_t header_size = ddp_header_size(payload);
+  const DDPPixelFormat format = ddp_pixel_format(payload[2]);
+  if (size < header_size + format.channels * format.channel_size) {
+    if ( this->ddp_debug_ > 0) {
+      ESP_LOGD("KAUF DDP Debug", "DDP packet w/o a full pixel of data (size=%d, type=%02x, timecode=%s)", size,
+               payload[2], YESNO(header_size == DDP_HEADER_SIZE_TIMECODE));
+    }
+    return false;
+  }
+
   // ignore packet if data offset != [00 00 00 00]
   if ( (payload[4] != 0) || (payload[5] != 0) || (payload[6] != 0) || (payload[7] != 0) ) {
     if ( this->ddp_debug_ > 0) {
@@ -341,49 +824,287 @@ bool LightState::parse_frame_(const uint8_t *payload, uint16_t size) {
       ESP_LOGD("KAUF DDP Debug", "DDP packet received: %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x [%02x %02x %02x]", payload[0], payload[1], payload[2], payload[3], payload[4], payload[5], payload[6], payload[7], payload[8], payload[9], payload[10], payload[11], payload[12] );
   }
 
-  float r = (float)payload[10]/255.0f;
-  float g = (float)payload[11]/255.0f;
-  float b = (float)payload[12]/255.0f;
+  float channels[DDP_MAX_CHANNELS] = {};
+  const uint8_t *data = payload + header_size;
+  for (uint8_t i = 0; i < format.channels; i++) {
+    if (format.channel_size == 2) {
+      channels[i] = (float)encode_uint16(data[2 * i], data[2 * i + 1])/65535.0f;
+    } else {
+      channels[i] = (float)data[i]/255.0f;
+    }
+  }
+
+  // frames with a timecode are shown at the time the sender scheduled them
+  optional<uint32_t> timecode{};
+  if (header_size == DDP_HEADER_SIZE_TIMECODE) {
+    timecode = encode_uint32(payload[10], payload[11], payload[12], payload[13]);
+  }
+  this->show_pixel_(format.color_mode, channels, timecode);
+
+  return true;
+
+}
+
+void LightState::show_pixel_(ColorMode color_mode, float *channels, optional<uint32_t> timecode) {
+  // RGB pixels are scaled to the light's brightness, pixels with white channels go straight to the outputs.
+  if (color_mode == ColorMode::RGB) {
+    float r = channels[0];
+    float g = channels[1];
+    float b = channels[2];
 
-  float max = 0.0f;
+    float max = 0.0f;
 
-  // find max for brightness scaling
-  if ( (r>=g) && (r>=b) ) { max = r; }
-  else if ( g >= b )      { max = g; }
-  else                    { max = b; }
+    // find max for brightness scaling
+    if ( (r>=g) && (r>=b) ) { max = r; }
+    else if ( g >= b )      { max = g; }
+    else                    { max = b; }
 
-  float scaled_r;
-  float scaled_g;
-  float scaled_b;
+    float scaled_r;
+    float scaled_g;
+    float scaled_b;
 
-  if ( this->remote_values.is_on() && (max != 0.0f) ) {
+    if ( this->remote_values.is_on() && (max != 0.0f) ) {
 
-    // scale max value to current set brightness of underlying light entity.
-    scaled_r = (r * this->remote_values.get_brightness()) / max;
-    scaled_g = (g * this->remote_values.get_brightness()) / max;
-    scaled_b = (b * this->remote_values.get_brightness()) / max;
+      // scale max value to current set brightness of underlying light entity.
+      scaled_r = (r * this->remote_values.get_brightness()) / max;
+      scaled_g = (g * this->remote_values.get_brightness()) / max;
+      scaled_b = (b * this->remote_values.get_brightness()) / max;
+    } else {
+
+      // if underlying light entity is off, just use received values directly.
+      scaled_r = r;
+      scaled_g = g;
+      scaled_b = b;
+    }
+
+    channels[0] = scaled_r;
+    channels[1] = scaled_g;
+    channels[2] = scaled_b;
+  }
+
+  // frames with a timecode wait for it even without the jitter buffer
+  if (this->ddp_jitter_buffer_ms_ > 0 || timecode.has_value()) {
+    const uint32_t now = millis();
+    optional<uint32_t> scheduled_ms{};
+    if (timecode.has_value()) {
+      scheduled_ms = this->ddp_timecode_to_ms_(*timecode, now);
+    }
+    // the latency is measured once play_ddp_frames_() shows the frame
+    this->push_ddp_frame_(now, scheduled_ms, color_mode, channels);
   } else {
+    this->apply_pixel_(color_mode, channels);
+    this->ddp_stats_.rx_us = this->ddp_packet_rx_us_.value_or(micros());
+    this->ddp_stats_.latency_pending = true;
+  }
 
-    // if underlying light entity is off, just use received values directly.
-    scaled_r = r;
-    scaled_g = g;
-    scaled_b = b;
+  // frame rate over windows of about a second
+  const uint32_t now = millis();
+  if (now - this->ddp_stats_.window_start_ms > 2000) {
+    // first frame after the stream (re)started
+    this->ddp_stats_.window_start_ms = now;
+    this->ddp_stats_.window_frames = 0;
+  }
+  this->ddp_stats_.frames++;
+  this->ddp_stats_.window_frames++;
+  if (now - this->ddp_stats_.window_start_ms >= 1000) {
+    this->ddp_stats_.fps = this->ddp_stats_.window_frames * 1000.0f / (now - this->ddp_stats_.window_start_ms);
+    this->ddp_stats_.window_start_ms = now;
+    this->ddp_stats_.window_frames = 0;
   }
+}
 
+void LightState::apply_pixel_(ColorMode color_mode, const float *channels) {
   // modify current values to what we received.
-  this->current_values.set_color_mode(ColorMode::RGB);
+  this->current_values.set_color_mode(color_mode);
   this->current_values.set_state(1.0f);
-  this->current_values.set_red(scaled_r);
-  this->current_values.set_green(scaled_g);
-  this->current_values.set_blue(scaled_b);
+  this->current_values.set_red(channels[0]);
+  this->current_values.set_green(channels[1]);
+  this->current_values.set_blue(channels[2]);
+  if (color_mode == ColorMode::RGB_WHITE) {
+    // the output splits this between cold and warm white by its color temperature
+    this->current_values.set_white(channels[3]);
+  } else if (color_mode == ColorMode::RGB_COLD_WARM_WHITE) {
+    this->current_values.set_cold_white(channels[3]);
+    this->current_values.set_warm_white(channels[4]);
+  }
   this->current_values.set_color_temperature(250);
   this->current_values.set_brightness(0.0f);
   this->current_values.use_raw = true;
 
   this->next_write_ = true;
+}
 
-  return true;
+void LightState::set_ddp_jitter_buffer(uint32_t jitter_buffer_ms) {
+  this->ddp_jitter_buffer_ms_ = jitter_buffer_ms;
+  this->ddp_frames_.resize(jitter_buffer_ms > 0 ? DDP_JITTER_FRAMES : 0);
+  this->ddp_frames_.shrink_to_fit();
+  this->ddp_frames_head_ = 0;
+  this->ddp_frames_count_ = 0;
+}
 
+optional<uint32_t> LightState::ddp_ntp_timecode_() const {
+  struct timeval now;
+  if (!this->ddp_ntp_clock_ || gettimeofday(&now, nullptr) != 0 || now.tv_sec < SYSTEM_CLOCK_VALID) {
+    return {};
+  }
+  const uint32_t seconds = uint32_t(now.tv_sec) + NTP_UNIX_OFFSET;
+  return (seconds << 16) | uint32_t((uint64_t(now.tv_usec) << 16) / 1000000u);
+}
+
+optional<uint32_t> LightState::ddp_timecode_to_ms_(uint32_t timecode, uint32_t arrival_ms) {
+  // DDP timecodes are the middle 32 bits of an NTP timestamp, 16 bit seconds and 16 bit fraction. The local clock is
+  // brought to the same units, so all the differences below can wrap around freely.
+
+  // With a synchronized clock the timecode is simply a wall time. This is the sender's own clock, so all bulbs agree
+  // on it whatever the delay of their path, including the hops of a chain before them.
+  const optional<uint32_t> ntp = this->ddp_ntp_timecode_();
+  if (ntp.has_value()) {
+    const int32_t ahead = int32_t(timecode - *ntp);
+    if (ahead < DDP_NTP_WINDOW && -ahead < DDP_NTP_WINDOW) {
+      return arrival_ms + int32_t((int64_t(ahead) * 1000 + 32768) >> 16);
+    }
+  }
+
+  // Otherwise the sender's clock is estimated from the stream. The offset found below includes the shortest delay
+  // of this bulb's path, so bulbs further down a chain show frames that much later.
+  const uint32_t local = uint32_t(uint64_t(arrival_ms) * 65536u / 1000u);
+  // clock offset plus the network delay of this packet
+  const uint32_t sample = local - timecode;
+
+  // The offset is estimated as the smallest sample, the one with the least delay, over the current and the previous
+  // window of packets. Starting a new window every so often lets the estimate follow clock drift.
+  if (!this->ddp_clock_valid_) {
+    this->ddp_clock_window_min_ = sample;
+    this->ddp_clock_prev_window_min_ = sample;
+    this->ddp_clock_window_count_ = 0;
+    this->ddp_clock_valid_ = true;
+  } else if (this->ddp_clock_window_count_ == 0 || int32_t(sample - this->ddp_clock_window_min_) < 0) {
+    this->ddp_clock_window_min_ = sample;
+  }
+  if (++this->ddp_clock_window_count_ == DDP_CLOCK_WINDOW) {
+    this->ddp_clock_prev_window_min_ = this->ddp_clock_window_min_;
+    this->ddp_clock_window_count_ = 0;
+  }
+  uint32_t offset = this->ddp_clock_window_min_;
+  if (int32_t(this->ddp_clock_prev_window_min_ - offset) < 0) {
+    offset = this->ddp_clock_prev_window_min_;
+  }
+
+  // how much later than the least delayed packets this one arrived
+  const int32_t late = int32_t(sample - offset);
+  if (late > 65536) {
+    // more than a second, the sender's clock jumped back. Start over with the next packet.
+    this->ddp_clock_valid_ = false;
+    return {};
+  }
+  // to the nearest millisecond, truncating would put some frames a loop later than the ones around them
+  return arrival_ms - uint32_t((int64_t(late) * 1000 + 32768) >> 16);
+}
+
+void LightState::push_ddp_frame_(uint32_t arrival_ms, optional<uint32_t> scheduled_ms, ColorMode color_mode,
+                                 const float *channels) {
+  if (this->ddp_frames_.empty()) {
+    // first frame with a timecode and no jitter buffer
+    this->ddp_frames_.resize(DDP_JITTER_FRAMES);
+    this->ddp_frames_head_ = 0;
+  }
+
+  // after a second without frames the stream stalled, start over instead of interpolating across the gap
+  if (this->ddp_frames_count_ > 0 && arrival_ms - this->ddp_last_arrival_ms_ > 1000) {
+    this->ddp_frames_count_ = 0;
+    this->ddp_frame_interval_ms_ = 0.0f;
+  }
+
+  // Arrival times carry the network jitter, so frames are placed on a smoothed timeline instead: one average
+  // frame interval after the previous frame, pulled slowly towards the actual arrival time. If the error gets
+  // larger than the buffer can absorb, follow the arrival time again.
+  uint32_t time_ms = scheduled_ms.value_or(arrival_ms);
+  if (this->ddp_frames_count_ > 0) {
+    const uint32_t interval = arrival_ms - this->ddp_last_arrival_ms_;
+    if (this->ddp_frame_interval_ms_ == 0.0f) {
+      this->ddp_frame_interval_ms_ = interval;
+    } else {
+      this->ddp_frame_interval_ms_ += (float(interval) - this->ddp_frame_interval_ms_) / 16.0f;
+    }
+
+    const uint8_t last_index = (this->ddp_frames_head_ + this->ddp_frames_count_ - 1) % DDP_JITTER_FRAMES;
+    const uint32_t last_time_ms = this->ddp_frames_[last_index].time_ms;
+    const uint32_t expected = last_time_ms + uint32_t(this->ddp_frame_interval_ms_);
+    const int32_t error = int32_t(arrival_ms - expected);
+    if (!scheduled_ms.has_value() && error < int32_t(this->ddp_jitter_buffer_ms_) &&
+        -error < int32_t(this->ddp_jitter_buffer_ms_)) {
+      time_ms = expected + error / 8;
+    }
+    // keep the timeline increasing, strictly with the buffer since interpolation divides by the difference
+    const uint32_t min_time_ms = this->ddp_jitter_buffer_ms_ > 0 ? last_time_ms + 1 : last_time_ms;
+    if (int32_t(time_ms - min_time_ms) < 0) {
+      time_ms = min_time_ms;
+    }
+  }
+  this->ddp_last_arrival_ms_ = arrival_ms;
+
+  // when full, drop the oldest frame
+  if (this->ddp_frames_count_ == DDP_JITTER_FRAMES) {
+    this->ddp_frames_head_ = (this->ddp_frames_head_ + 1) % DDP_JITTER_FRAMES;
+    this->ddp_frames_count_--;
+    this->ddp_frame_held_ = false;
+  }
+  DDPFrame &frame = this->ddp_frames_[(this->ddp_frames_head_ + this->ddp_frames_count_) % DDP_JITTER_FRAMES];
+  frame.time_ms = time_ms;
+  frame.rx_us = this->ddp_packet_rx_us_.value_or(micros());
+  frame.shown = false;
+  frame.color_mode = color_mode;
+  memcpy(frame.channels, channels, sizeof(frame.channels));
+  this->ddp_frames_count_++;
+  if (this->ddp_frames_count_ == 1) {
+    this->ddp_frame_held_ = false;
+  }
+}
+
+void LightState::play_ddp_frames_() {
+  if (this->ddp_frames_count_ == 0) {
+    return;
+  }
+  const uint32_t now = millis() - this->ddp_jitter_buffer_ms_;
+
+  // drop the oldest frame once playout has reached the one after it
+  while (this->ddp_frames_count_ > 1 &&
+         int32_t(now - this->ddp_frames_[(this->ddp_frames_head_ + 1) % DDP_JITTER_FRAMES].time_ms) >= 0) {
+    this->ddp_frames_head_ = (this->ddp_frames_head_ + 1) % DDP_JITTER_FRAMES;
+    this->ddp_frames_count_--;
+    this->ddp_frame_held_ = false;
+  }
+
+  DDPFrame &from = this->ddp_frames_[this->ddp_frames_head_];
+  if (int32_t(now - from.time_ms) < 0) {
+    // not due yet
+    return;
+  }
+
+  // the output starts at this frame now, so its latency runs from receiving it to the write in loop()
+  if (!from.shown) {
+    from.shown = true;
+    this->ddp_stats_.rx_us = from.rx_us;
+    this->ddp_stats_.latency_pending = true;
+  }
+
+  if (this->ddp_frames_count_ == 1 || this->ddp_jitter_buffer_ms_ == 0) {
+    // nothing newer to interpolate to (or no buffer to interpolate in), hold the frame until the next one is due
+    if (!this->ddp_frame_held_) {
+      this->apply_pixel_(from.color_mode, from.channels);
+      this->ddp_frame_held_ = true;
+    }
+    return;
+  }
+
+  // interpolate towards the next frame the same way the Kauf transition does
+  const DDPFrame &to = this->ddp_frames_[(this->ddp_frames_head_ + 1) % DDP_JITTER_FRAMES];
+  const float progress = float(now - from.time_ms) / float(to.time_ms - from.time_ms);
+  float channels[DDP_MAX_CHANNELS];
+  for (uint8_t i = 0; i < DDP_MAX_CHANNELS; i++) {
+    channels[i] = LightTransitionTransformer::convert_to_kauf(from.channels[i], to.channels[i], progress);
+  }
+  this->apply_pixel_(to.color_mode, channels);
 }
 
 float LightState::get_setup_priority() const { return setup_priority::HARDWARE - 1.0f; }
@@ -391,11 +1112,12 @@ float LightState::get_setup_priority() const { return setup_priority::HARDWARE -
 void LightState::publish_state() { this->remote_values_callback_.call(); }
 
 LightOutput *LightState::get_output() const { return this->output_; }
-std::string LightState::get_effect_name() {
+const std::string &LightState::get_effect_name() {
+  static const std::string NONE_EFFECT_NAME = "None";
   if (this->active_effect_index_ > 0) {
     return this->effects_[this->active_effect_index_ - 1]->get_name();
   } else {
-    return "None";
+    return NONE_EFFECT_NAME;
   }
 }
 
@@ -414,7 +1136,10 @@ void LightState::set_flash_transition_length(uint32_t flash_transition_length) {
   this->flash_transition_length_ = flash_transition_length;
 }
 uint32_t LightState::get_flash_transition_length() const { return this->flash_transition_length_; }
-void LightState::set_gamma_correct(float gamma_correct) { this->gamma_correct_ = gamma_correct; }
+void LightState::set_gamma_correct(float gamma_correct) {
+  this->gamma_correct_ = gamma_correct;
+  this->gamma_table_ = nullptr;
+}
 void LightState::set_restore_mode(LightRestoreMode restore_mode) { this->restore_mode_ = restore_mode; }
 bool LightState::supports_effects() { return !this->effects_.empty(); }
 const std::vector<LightEffect *> &LightState::get_effects() const { return this->effects_; }
@@ -426,16 +1151,43 @@ void LightState::add_effects(const std::vector<LightEffect *> &effects) {
 }
 
 void LightState::current_values_as_binary(bool *binary) { this->current_values.as_binary(binary); }
+float LightState::gamma_correct_lookup_(float value) const {
+  if (this->gamma_table_ == nullptr)
+    return gamma_correct(value, this->gamma_correct_);
+  if (value <= 0.0f)
+    return 0.0f;
+  if (value >= 1.0f)
+    return 1.0f;
+
+  // linear interpolation between the two closest entries, read byte-wise as the table lives in PROGMEM
+  const float pos = value * (GAMMA_TABLE_SIZE - 1);
+  const uint16_t index = static_cast<uint16_t>(pos);
+  const uint8_t *entry = reinterpret_cast<const uint8_t *>(&this->gamma_table_[index]);
+  uint8_t bytes[4];
+  for (uint8_t i = 0; i < 4; i++)
+    bytes[i] = progmem_read_byte(&entry[i]);
+  uint16_t low, high;
+  memcpy(&low, &bytes[0], sizeof(low));
+  memcpy(&high, &bytes[2], sizeof(high));
+  return (low + (float(high) - float(low)) * (pos - index)) / 65535.0f;
+}
+
 void LightState::current_values_as_brightness(float *brightness) {
-  this->current_values.as_brightness(brightness, this->gamma_correct_);
+  this->current_values.as_brightness(brightness);
+  *brightness = this->gamma_correct_lookup_(*brightness);
 }
 void LightState::current_values_as_rgb(float *red, float *green, float *blue, bool color_interlock) {
-  auto traits = this->get_traits();
-  this->current_values.as_rgb(red, green, blue, this->gamma_correct_, false);
+  this->current_values.as_rgb(red, green, blue);
+  *red = this->gamma_correct_lookup_(*red);
+  *green = this->gamma_correct_lookup_(*green);
+  *blue = this->gamma_correct_lookup_(*blue);
 }
 void LightState::current_values_as_rgbw(float *red, float *green, float *blue, float *white, bool color_interlock) {
-  auto traits = this->get_traits();
-  this->current_values.as_rgbw(red, green, blue, white, this->gamma_correct_, false);
+  this->current_values.as_rgbw(red, green, blue, white);
+  *red = this->gamma_correct_lookup_(*red);
+  *green = this->gamma_correct_lookup_(*green);
+  *blue = this->gamma_correct_lookup_(*blue);
+  *white = this->gamma_correct_lookup_(*white);
 }
 void LightState::current_values_as_rgbww(float *red, float *green, float *blue, float *cold_white, float *warm_white,
                                          bool constant_brightness) {
@@ -445,16 +1197,19 @@ void LightState::current_values_as_rgbct(float *red, float *green, float *blue,
                                          float *white_brightness) {
   auto traits = this->get_traits();
   this->current_values.as_rgbct(traits.get_min_mireds(), traits.get_max_mireds(), red, green, blue, color_temperature,
-                                white_brightness, this->gamma_correct_);
+                                white_brightness);
+  *red = this->gamma_correct_lookup_(*red);
+  *green = this->gamma_correct_lookup_(*green);
+  *blue = this->gamma_correct_lookup_(*blue);
+  *white_brightness = this->gamma_correct_lookup_(*white_brightness);
 }
 void LightState::current_values_as_cwww(float *cold_white, float *warm_white, bool constant_brightness) {
-  auto traits = this->get_traits();
   this->current_values.as_cwww(cold_white, warm_white, this->gamma_correct_, constant_brightness);
 }
 void LightState::current_values_as_ct(float *color_temperature, float *white_brightness) {
   auto traits = this->get_traits();
-  this->current_values.as_ct(traits.get_min_mireds(), traits.get_max_mireds(), color_temperature, white_brightness,
-                             this->gamma_correct_);
+  this->current_values.as_ct(traits.get_min_mireds(), traits.get_max_mireds(), color_temperature, white_brightness);
+  *white_brightness = this->gamma_correct_lookup_(*white_brightness);
 }
 
 bool LightState::is_transformer_active() { return this->is_transformer_active_; }
@@ -466,6 +1221,8 @@ void LightState::start_effect_(uint32_t effect_index) {
 
   this->active_effect_index_ = effect_index;
   auto *effect = this->get_active_effect_();
+  effect->clear_wake_time();
+  effect->reset_random();
   effect->start_internal();
 }
 LightEffect *LightState::get_active_effect_() {
@@ -484,7 +1241,9 @@ void LightState::stop_effect_() {
 }
 
 void LightState::start_transition_(const LightColorValues &target, uint32_t length, bool set_remote_values) {
-  this->transformer_ = this->output_->create_default_transition();
+  if (this->transition_transformer_ == nullptr)
+    this->transition_transformer_ = this->output_->create_default_transition();
+  this->transformer_ = this->transition_transformer_.get();
   this->transformer_->setup(this->current_values, target, length);
 
   if (set_remote_values) {
@@ -499,7 +1258,9 @@ void LightState::start_flash_(const LightColorValues &target, uint32_t length, b
   if (this->transformer_ != nullptr)
     end_colors = this->transformer_->get_start_values();
 
-  this->transformer_ = make_unique<LightFlashTransformer>(*this);
+  if (this->flash_transformer_ == nullptr)
+    this->flash_transformer_ = make_unique<LightFlashTransformer>(*this);
+  this->transformer_ = this->flash_transformer_.get();
   this->transformer_->setup(end_colors, target, length);
 
   if (set_remote_values) {
@@ -4,6 +4,7 @@
 #include "esphome/core/entity_base.h"
 #include "esphome/core/optional.h"
 #include "esphome/core/preferences.h"
+#include "esphome/components/globals/globals_component.h"
 #include "light_call.h"
 #include "light_color_values.h"
 #include "light_effect.h"
@@ -14,10 +15,18 @@
 // following needed for receiving and sending DDP packets.
 #include <vector>
 #include <memory>
+
+// The DDP, E1.31 and Art-Net sockets use the Arduino WiFiUDP of the ESP8266 core. The host test build (tests/host)
+// defines USE_LIGHT_UDP itself and provides an in-memory WiFiUDP.
+#ifdef USE_ESP8266
+#define USE_LIGHT_UDP
+#endif
+#ifdef USE_LIGHT_UDP
 #include <ESP8266WiFi.h>
 #include <WiFiUdp.h>
 #include "esphome/components/network/ip_address.h"
 #include "esphome/components/wifi/wifi_component.h"
+#endif
 
 namespace esphome {
 namespace light {
@@ -62,20 +71,116 @@ class LightState : public EntityBase, public Component {
   /// Shortly after HARDWARE.
   float get_setup_priority() const override;
 
+#ifdef USE_LIGHT_UDP
   // for receiving UDP packets
   std::unique_ptr<WiFiUDP> udp_;
+  std::unique_ptr<WiFiUDP> e131_udp_;
+  std::unique_ptr<WiFiUDP> artnet_udp_;
+  /// The packet being read from any of the sockets, kept at the size of the largest so far instead of allocated for
+  /// every packet.
+  std::vector<uint8_t> udp_packet_;
+#endif
 
   // functions added for WLED / DDP support
   void wled_apply();
   bool parse_frame_(const uint8_t *payload, uint16_t size);
-  void set_use_wled(bool use_wled) { this->use_wled_ = use_wled; }
-  void set_use_wled() { this->use_wled_ = true; }
-  void clr_use_wled() { this->use_wled_ = false; }
+
+  // E1.31 (sACN) and Art-Net receiving, enabled together with DDP.  They feed the same path as DDP frames.
+  void dmx_apply();
+  bool parse_e131_(const uint8_t *payload, uint16_t size);
+  bool parse_artnet_(const uint8_t *payload, uint16_t size);
+  void set_e131_universe(uint16_t universe) { this->e131_universe_ = universe; }
+  void set_artnet_universe(uint16_t universe) {
+    this->artnet_universe_ = universe;
+    this->use_artnet_ = true;
+  }
+  /// First DMX channel (1-512) of this light.
+  void set_dmx_start_channel(uint16_t start_channel) { this->dmx_start_channel_ = start_channel; }
+  /// Number of DMX channels of this light: 3 for RGB, 4 for RGBW or 5 for RGB + cold white + warm white.
+  void set_dmx_channels(uint8_t channels) { this->dmx_channels_ = channels; }
+  void set_use_wled(bool use_wled) {
+    this->use_wled_ = use_wled;
+    this->idle_ = false;
+  }
+  void set_use_wled() { this->set_use_wled(true); }
+  void clr_use_wled() { this->set_use_wled(false); }
 
   void set_ddp_debug(int ddp_debug) { this->ddp_debug_ = ddp_debug; }
 
+  /** Delay DDP frames by this many milliseconds and interpolate between them, to hide network jitter.
+   *
+   * 0 (the default) applies every frame as soon as it is received, or at its timecode if it has one.
+   */
+  void set_ddp_jitter_buffer(uint32_t jitter_buffer_ms);
+  /** Schedule DDP timecodes by the system clock once SNTP has set it.
+   *
+   * DDP timecodes are NTP time, so with a synchronized clock every bulb shows a frame at the same wall time, however
+   * many hops it took to get there. Without it (or for senders whose timecodes aren't NTP time) the sender's clock is
+   * estimated from the stream, which can't tell the clock offset from the shortest delay of the path to this bulb.
+   */
+  void set_ddp_ntp_clock(bool ntp_clock) { this->ddp_ntp_clock_ = ntp_clock; }
+
+  // DDP stream health, counted since boot or the last reset_ddp_stats().
+  /// Number of DDP packets received with at least a full header.
+  uint32_t get_ddp_packets() const { return this->ddp_stats_.packets; }
+  /// Number of DDP packets applied to the light.
+  uint32_t get_ddp_frames() const { return this->ddp_stats_.frames; }
+  /** Number of packets missing according to the DDP sequence numbers.
+   *
+   * These only count to 15, so a run of 7-12 lost packets is counted once the two packets after it arrive, and longer
+   * runs can't be told from late or repeated packets. A late packet was already counted as lost when the one after it
+   * came, and two late ones in a row look like a loss of 7 or more.
+   */
+  uint32_t get_ddp_seq_gaps() const { return this->ddp_stats_.seq_gaps; }
+  /// Number of bytes forwarded to the next bulbs in the chain.
+  uint32_t get_ddp_bytes_forwarded() const { return this->ddp_stats_.bytes_forwarded; }
+  /// Applied frames per second over the last second or so, 0 once the stream stops.
+  float get_ddp_fps() const;
+  /// Smoothed inter-arrival jitter in ms, estimated like RFC 3550 from the change between arrival intervals.
+  float get_ddp_jitter() const { return this->ddp_stats_.jitter_us / 1000.0f; }
+  /// Upper bound in ms of the given percentile (0-1) of inter-arrival jitter over the last few seconds, at power of two
+  /// resolution. 0 once the stream stops.
+  float get_ddp_jitter_percentile(float percentile) const;
+  /// Smoothed time in ms from receiving a frame to writing it to the outputs.
+  float get_ddp_latency() const { return this->ddp_stats_.latency_us / 1000.0f; }
+  /// Longest time in ms from receiving a frame to writing it to the outputs.
+  float get_ddp_max_latency() const { return this->ddp_stats_.max_latency_us / 1000.0f; }
+  void reset_ddp_stats() { this->ddp_stats_ = DDPStats(); }
+
   void set_next_write() { this->next_write_ = true; }
 
+  /// Log the cycle count histograms of all loop stages, or that this light doesn't run the loop profiler.
+  void dump_loop_profile();
+
+#ifdef USE_LIGHT_LOOP_PROFILER
+  /// Stages of loop() timed by the loop profiler (enabled with the loop_profiler light option).
+  enum LoopStage : uint8_t {
+    LOOP_STAGE_EFFECT = 0,
+    LOOP_STAGE_WLED,
+    LOOP_STAGE_TRANSFORMER,
+    LOOP_STAGE_AUX,
+    LOOP_STAGE_WRITE,
+    LOOP_STAGE_COUNT,
+  };
+  /// Histogram bucket i counts the stage runs that took [2^i, 2^(i+1)) CPU cycles, the last one everything longer.
+  static constexpr uint8_t LOOP_PROFILE_BUCKETS = 24;
+
+  /// Time the loop stages of this light. Built in when any light has the loop_profiler option, only those record.
+  void set_loop_profiler(bool enabled);
+  /// Clear all recorded loop stage timings.
+  void reset_loop_profile();
+  /// Number of times the stage ran since the last reset.
+  uint32_t get_loop_profile_count(LoopStage stage) const {
+    return this->loop_profile_.empty() ? 0 : this->loop_profile_[stage].count;
+  }
+  /// Longest run of the stage in CPU cycles since the last reset.
+  uint32_t get_loop_profile_max_cycles(LoopStage stage) const {
+    return this->loop_profile_.empty() ? 0 : this->loop_profile_[stage].max_cycles;
+  }
+  /// Average run of the stage in CPU cycles since the last reset, 0 if it never ran.
+  float get_loop_profile_mean_cycles(LoopStage stage) const;
+#endif
+
   /** The current values of the light as outputted to the light.
    *
    * These values represent the "real" state of the light - During transitions this
@@ -107,7 +212,7 @@ class LightState : public EntityBase, public Component {
   LightOutput *get_output() const;
 
   /// Return the name of the current effect, or if no effect is active "None".
-  std::string get_effect_name();
+  const std::string &get_effect_name();
 
   /**
    * This lets front-end components subscribe to light change events. This callback is called once
@@ -136,6 +241,13 @@ class LightState : public EntityBase, public Component {
   /// Set the gamma correction factor
   void set_gamma_correct(float gamma_correct);
   float get_gamma_correct() const { return this->gamma_correct_; }
+  /** Use a gamma table generated at compile time for the gamma correction factor (in PROGMEM).
+   *
+   * The table holds GAMMA_TABLE_SIZE gamma corrected levels scaled to 0-65535, values in between are interpolated.
+   * Changing the gamma correction factor afterwards drops the table again.
+   */
+  void set_gamma_table(const uint16_t *gamma_table) { this->gamma_table_ = gamma_table; }
+  static constexpr uint16_t GAMMA_TABLE_SIZE = 1024;
 
   /// Set the restore mode of this light
   void set_restore_mode(LightRestoreMode restore_mode);
@@ -208,6 +320,9 @@ protected:
   friend LightCall;
   friend class AddressableLight;
 
+  /// Apply the gamma correction to an output level, from the gamma table if there is one.
+  float gamma_correct_lookup_(float value) const;
+
   /// Internal method to start an effect with the given index
   void start_effect_(uint32_t effect_index);
   /// Internal method to get the currently active effect
@@ -223,14 +338,33 @@ protected:
   /// Internal method to set the color values to target immediately (with no transition).
   void set_immediately_(const LightColorValues &target, bool set_remote_values);
 
+#ifdef USE_LIGHT_LOOP_PROFILER
+  struct LoopStageProfile {
+    uint32_t count;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+    uint32_t buckets[LOOP_PROFILE_BUCKETS];
+  };
+  /// Add one run of a loop stage that took the given number of CPU cycles to its histogram.
+  void record_loop_stage_(LoopStage stage, uint32_t cycles);
+  /// One profile per stage, only allocated while the profiler is enabled for this light.
+  std::vector<LoopStageProfile> loop_profile_;
+#endif
+
   /// Store the output to allow effects to have more access.
   LightOutput *output_;
   /// Value for storing the index of the currently active effect. 0 if no effect is active
   uint32_t active_effect_index_{};
-  /// The currently active transformer for this light (transition/flash).
-  std::unique_ptr<LightTransformer> transformer_{nullptr};
+  /// The currently active transformer for this light (transition/flash), points to one of the two below.
+  LightTransformer *transformer_{nullptr};
+  /// Transformers are created on first use and reused afterwards, to avoid a heap allocation for every call.
+  std::unique_ptr<LightTransformer> transition_transformer_{nullptr};
+  std::unique_ptr<LightTransformer> flash_transformer_{nullptr};
   /// Whether the light value should be written in the next cycle.
   bool next_write_{true};
+  /// Whether loop() has nothing to do until a write is scheduled, a call is performed, WLED is toggled or an aux
+  /// light changes.
+  bool idle_{false};
 
   /// Object used to store the persisted values of the light.
   ESPPreferenceObject rtc_;
@@ -255,6 +389,8 @@ protected:
   uint32_t flash_transition_length_{};
   /// Gamma correction factor for the light.
   float gamma_correct_{};
+  /// Compile time gamma table for gamma_correct_, if any.
+  const uint16_t *gamma_table_{nullptr};
   /// Restore mode of the light.
   LightRestoreMode restore_mode_;
   /// List of effects for this light.
@@ -266,6 +402,107 @@ protected:
   bool use_wled_ = false;
   uint32_t ddp_debug_ = 0;
 
+  /// E1.31 universe to listen on, 0 for none.
+  uint16_t e131_universe_{0};
+  uint16_t artnet_universe_{0};
+  bool use_artnet_{false};
+  uint16_t dmx_start_channel_{1};
+  /// millis() of the last attempt to bind the E1.31 or Art-Net socket, 0 for none yet.
+  uint32_t dmx_last_bind_ms_{0};
+  uint8_t dmx_channels_{3};
+
+  /** micros() right after parsePacket() returned the packet being parsed, where the receive to output latency starts.
+   *
+   * Unset while parsing a packet that didn't come from the sockets of this light, which then counts from parsing.
+   */
+  optional<uint32_t> ddp_packet_rx_us_{};
+  /// Update the DDP stream counters for a received packet with a full header.
+  void record_ddp_packet_(const uint8_t *payload);
+  /// Most channels in a DDP pixel: RGB + cold white + warm white.
+  static constexpr uint8_t DDP_MAX_CHANNELS = 5;
+  /** Show a received DDP, E1.31 or Art-Net pixel now or through the jitter buffer, and count it as a frame.
+   *
+   * channels holds red, green, blue and then white for RGB_WHITE or cold and warm white for RGB_COLD_WARM_WHITE.
+   * RGB pixels are scaled to the light's brightness in place.
+   */
+  void show_pixel_(ColorMode color_mode, float *channels, optional<uint32_t> timecode);
+  /// Set a received pixel (already gamma corrected) as the light's current values.
+  void apply_pixel_(ColorMode color_mode, const float *channels);
+  /// Show this light's channels out of a DMX universe.
+  bool parse_dmx_(const uint8_t *dmx, uint16_t length);
+  /// Queue a received frame in the jitter buffer, at the given (local) time or else on a smoothed arrival timeline.
+  void push_ddp_frame_(uint32_t arrival_ms, optional<uint32_t> scheduled_ms, ColorMode color_mode,
+                       const float *channels);
+  /// Map a DDP timecode to local millis(), by the system clock or the clock offset estimated from the stream.
+  optional<uint32_t> ddp_timecode_to_ms_(uint32_t timecode, uint32_t arrival_ms);
+  /// The system clock as a DDP timecode (middle 32 bits of NTP time), none unless set_ddp_ntp_clock() and set.
+  optional<uint32_t> ddp_ntp_timecode_() const;
+  /// Apply the queued frames due at the current time, called every loop while DDP is enabled.
+  void play_ddp_frames_();
+
+  /// Number of frames the jitter buffer can hold, enough for the maximum delay at 50 fps.
+  static constexpr uint8_t DDP_JITTER_FRAMES = 16;
+  struct DDPFrame {
+    /// Playout time on the smoothed timeline, before adding the buffer delay.
+    uint32_t time_ms;
+    /// micros() when the packet was received, and whether playout has reached the frame yet.
+    uint32_t rx_us;
+    bool shown;
+    ColorMode color_mode;
+    float channels[DDP_MAX_CHANNELS];
+  };
+  uint32_t ddp_jitter_buffer_ms_{0};
+  bool ddp_ntp_clock_{false};
+  /// Ring of queued frames, only allocated with the jitter buffer or once a frame with a timecode arrives.
+  std::vector<DDPFrame> ddp_frames_;
+  uint8_t ddp_frames_head_{0};
+  uint8_t ddp_frames_count_{0};
+  /// Whether the oldest buffered frame has been shown on its own, once there is nothing to interpolate to.
+  bool ddp_frame_held_{false};
+  uint32_t ddp_last_arrival_ms_{0};
+  float ddp_frame_interval_ms_{0.0f};
+
+  /// Packets per window of the DDP timecode clock offset estimator.
+  static constexpr uint8_t DDP_CLOCK_WINDOW = 64;
+  /// Smallest local clock minus timecode (both in 1/65536 s) of the current and the previous window.
+  uint32_t ddp_clock_window_min_{0};
+  uint32_t ddp_clock_prev_window_min_{0};
+  uint8_t ddp_clock_window_count_{0};
+  bool ddp_clock_valid_{false};
+
+  /// Histogram bucket i counts inter-arrival jitter of [2^i, 2^(i+1)) us, the last one everything longer.
+  static constexpr uint8_t DDP_JITTER_BUCKETS = 20;
+  /// A pause in the stream longer than this starts a new one for the jitter statistics.
+  static constexpr uint32_t DDP_STREAM_TIMEOUT_US = 2000000;
+  struct DDPStats {
+    uint32_t packets{0};
+    uint32_t frames{0};
+    uint32_t seq_gaps{0};
+    uint32_t bytes_forwarded{0};
+    /// Sequence number of the last packet, 0 if none or the sender doesn't use them.
+    uint8_t last_seq{0};
+    /// Sequence number and step of the last packet that was behind last_seq, 0 if the last one wasn't.
+    uint8_t behind_seq{0};
+    uint8_t behind_step{0};
+    uint32_t last_arrival_us{0};
+    uint32_t last_interval_us{0};
+    /// Packets of the current stream, up to the 2 needed for an arrival interval and its change.
+    uint8_t stream_packets{0};
+    float jitter_us{0.0f};
+    /// Jitter histogram, halved at the start of every window.
+    uint32_t jitter_buckets[DDP_JITTER_BUCKETS]{};
+    uint32_t jitter_window_start_us{0};
+    /// Frames counted in the current fps window and the rate of the last completed one.
+    uint32_t window_start_ms{0};
+    uint32_t window_frames{0};
+    float fps{0.0f};
+    /// Receive time of the last frame shown, if it hasn't been written to the outputs yet.
+    uint32_t rx_us{0};
+    bool latency_pending{false};
+    float latency_us{0.0f};
+    uint32_t max_latency_us{0};
+  } ddp_stats_;
+
 };
 
 }  // namespace light
@@ -107,6 +107,8 @@ class LightTransitionTransformer : public LightTransformer {
   // transition from 0 to 1 on x = [0, 1]
   static float smoothed_progress(float x) { return x * x * x * (x * (x * 6.0f - 15.0f) + 10.0f); }
 
+ public:
+  // also used by LightState to interpolate between buffered DDP frames.
   static float convert_to_kauf(float start, float end, float progress) {
 
     // begin and end are actual output values for the start and end points with gamma and everything,
@@ -167,10 +169,8 @@ class LightTransitionTransformer : public LightTransformer {
 
   }
 
-
-  bool changing_color_mode_{false};
+ protected:
   LightColorValues end_values_{};
-  LightColorValues intermediate_values_{};
 };
 
 class LightFlashTransformer : public LightTransformer {
@@ -184,27 +184,32 @@ class LightFlashTransformer : public LightTransformer {
 
     this->begun_lightstate_restore_ = false;
 
+    // both transitions of the flash reuse the same transformer
+    if (this->transformer_ == nullptr)
+      this->transformer_ = this->state_.get_output()->create_default_transition();
+
     // first transition to original target
-    this->transformer_ = this->state_.get_output()->create_default_transition();
     this->transformer_->setup(this->state_.current_values, this->target_values_, this->transition_length_);
+    this->transition_active_ = true;
   }
 
   optional<LightColorValues> apply() override {
     optional<LightColorValues> result = {};
 
-    if (this->transformer_ == nullptr && millis() > this->start_time_ + this->length_ - this->transition_length_) {
+    if (!this->transition_active_ && !this->begun_lightstate_restore_ &&
+        millis() > this->start_time_ + this->length_ - this->transition_length_) {
       // second transition back to start value
-      this->transformer_ = this->state_.get_output()->create_default_transition();
       this->transformer_->setup(this->state_.current_values, this->get_start_values(), this->transition_length_);
+      this->transition_active_ = true;
       this->begun_lightstate_restore_ = true;
     }
 
-    if (this->transformer_ != nullptr) {
+    if (this->transition_active_) {
       result = this->transformer_->apply();
 
       if (this->transformer_->is_finished()) {
         this->transformer_->stop();
-        this->transformer_ = nullptr;
+        this->transition_active_ = false;
       }
     }
 
@@ -213,9 +218,9 @@ class LightFlashTransformer : public LightTransformer {
 
   // Restore the original values after the flash.
   void stop() override {
-    if (this->transformer_ != nullptr) {
+    if (this->transition_active_) {
       this->transformer_->stop();
-      this->transformer_ = nullptr;
+      this->transition_active_ = false;
     }
     this->state_.current_values = this->get_start_values();
     this->state_.remote_values = this->get_start_values();
@@ -228,6 +233,7 @@ class LightFlashTransformer : public LightTransformer {
   LightState &state_;
   uint32_t transition_length_;
   std::unique_ptr<LightTransformer> transformer_{nullptr};
+  bool transition_active_{false};
   bool begun_lightstate_restore_;
 };
 
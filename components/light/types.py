@@ -30,6 +30,7 @@ COLOR_MODES = {
 ToggleAction = light_ns.class_("ToggleAction", automation.Action)
 LightControlAction = light_ns.class_("LightControlAction", automation.Action)
 DimRelativeAction = light_ns.class_("DimRelativeAction", automation.Action)
+DumpLoopProfileAction = light_ns.class_("DumpLoopProfileAction", automation.Action)
 AddressableSet = light_ns.class_("AddressableSet", automation.Action)
 LightIsOnCondition = light_ns.class_("LightIsOnCondition", automation.Condition)
 LightIsOffCondition = light_ns.class_("LightIsOffCondition", automation.Condition)
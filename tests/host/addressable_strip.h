@@ -0,0 +1,81 @@
+#pragma once
+
+#include "esphome/components/light/addressable_light.h"
+#include "esphome/components/power_supply/power_supply.h"
+#include "host.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace esphome {
+namespace testing {
+
+/// An RGBW pixel strip in memory, laid out like the buffers of the NeoPixelBus and FastLED outputs.
+class StripOutput : public light::AddressableLight {
+ public:
+  explicit StripOutput(int32_t size) : pixels_(size * 4, 0), effect_data_(size, 0) {}
+
+  int32_t size() const override { return int32_t(this->effect_data_.size()); }
+  void clear_effect_data() override { std::fill(this->effect_data_.begin(), this->effect_data_.end(), 0); }
+  light::LightTraits get_traits() override {
+    light::LightTraits traits;
+    traits.set_supported_color_modes({light::ColorMode::RGB_WHITE});
+    return traits;
+  }
+  void write_state(light::LightState *state) override {
+    this->mark_shown_();
+    this->writes++;
+  }
+
+  /// Corrected channel values as they would go out to the strip, RGBW for each pixel.
+  std::vector<uint8_t> &pixels() { return this->pixels_; }
+  const light::ESPColorCorrection &correction() const { return this->correction_; }
+
+  uint32_t writes{0};
+
+ protected:
+  light::ESPColorView get_view_internal(int32_t index) const override {
+    uint8_t *pixel = &this->pixels_[index * 4];
+    return {pixel, pixel + 1, pixel + 2, pixel + 3, &this->effect_data_[index], &this->correction_};
+  }
+
+  mutable std::vector<uint8_t> pixels_;
+  mutable std::vector<uint8_t> effect_data_;
+};
+
+/// A light on an addressable strip, set up like an ESPHome addressable light platform. Without a default transition,
+/// because the KAUF transition filter drops calls in RGBW mode while one is running.
+struct AddressableStrip {
+  power_supply::PowerSupply power;
+  StripOutput output;
+  light::AddressableLightState light{&output};
+
+  explicit AddressableStrip(int32_t size) : output(size) {
+    this->output.set_power_supply(&this->power);
+    this->light.set_name("Strip");
+    this->light.set_default_transition_length(0);
+    this->light.set_restore_mode(light::LIGHT_ALWAYS_OFF);
+  }
+
+  void setup() {
+    this->output.call_setup();
+    this->light.setup();
+    this->loop();
+  }
+
+  void loop() { this->light.loop(); }
+
+  /// Show the strip as the platform does after changing pixels itself.
+  void show() { this->output.write_state(&this->light); }
+
+  /// Run the loop every interval_ms on the simulated clock for duration_ms.
+  void run_for(uint32_t duration_ms, uint32_t interval_ms = 16) {
+    for (uint32_t t = 0; t < duration_ms; t += interval_ms) {
+      host::advance_ms(interval_ms);
+      this->loop();
+    }
+  }
+};
+
+}  // namespace testing
+}  // namespace esphome
@@ -0,0 +1,185 @@
+#include "addressable_strip.h"
+#include "esphome/components/light/addressable_light_effect.h"
+#include "runner.h"
+
+#include <cstdio>
+
+using namespace esphome;
+using namespace esphome::light;
+using namespace esphome::testing;
+
+namespace {
+
+/// Fill the strip with colors that change from pixel to pixel.
+void fill_gradient(StripOutput &output) {
+  for (int32_t i = 0; i < output.size(); i++)
+    output[i] = Color(i * 7, 255 - i * 3, i * 13, i);
+}
+
+/// The strip as an effect sees it, a light of unknown type, so the benchmark can't call its views directly.
+AddressableLight &opaque(StripOutput &output) {
+  AddressableLight *light = &output;
+  asm volatile("" : "+r"(light));
+  return *light;
+}
+
+}  // namespace
+
+TEST_CASE(bench_addressable_transition_step) {
+  // one step of the addressable transition over the whole strip: the blend on its own, and the get()/set() through
+  // the color correction that every pixel still pays for
+  for (int32_t size : {50, 300, 1000}) {
+    StripOutput output(size);
+    fill_gradient(output);
+    const Color add = Color(255, 64, 0, 32) * uint8_t(20);
+    char name[64];
+
+    snprintf(name, sizeof(name), "%d LEDs, add + led.get() * inv_alpha8", size);
+    bench(name, 200000 / size, [&](uint32_t i) {
+      const uint8_t alpha8 = 1 + i % 64;
+      const uint8_t inv_alpha8 = 255 - alpha8;
+      for (auto led : output)
+        led.set(add + led.get() * inv_alpha8);
+    });
+    fill_gradient(output);
+    snprintf(name, sizeof(name), "%d LEDs, blend()", size);
+    bench(name, 200000 / size, [&](uint32_t i) {
+      const uint8_t alpha8 = 1 + i % 64;
+      for (auto led : output)
+        led.set(AddressableLightTransformer::blend(led.get(), add, alpha8));
+    });
+    snprintf(name, sizeof(name), "%d LEDs, led.set(led.get()) alone", size);
+    bench(name, 200000 / size, [&](uint32_t) {
+      for (auto led : output)
+        led.set(led.get());
+    });
+
+    // the blend without the per-pixel views, on the colors in a plain array
+    std::vector<Color> colors(size);
+    for (int32_t i = 0; i < size; i++)
+      colors[i] = output[i].get();
+    snprintf(name, sizeof(name), "%d colors, operators without views", size);
+    bench(name, 200000 / size, [&](uint32_t i) {
+      const uint8_t inv_alpha8 = 255 - (1 + i % 64);
+      for (auto &color : colors)
+        color = add + color * inv_alpha8;
+      do_not_optimize(colors[0]);
+    });
+    snprintf(name, sizeof(name), "%d colors, blend() without views", size);
+    bench(name, 200000 / size, [&](uint32_t i) {
+      const uint8_t alpha8 = 1 + i % 64;
+      for (auto &color : colors)
+        color = AddressableLightTransformer::blend(color, add, alpha8);
+      do_not_optimize(colors[0]);
+    });
+  }
+}
+
+TEST_CASE(bench_addressable_rainbow) {
+  // one frame of the rainbow effect, against converting every LED's hue and setting its channels one by one
+  for (int32_t size : {60, 300, 1000}) {
+    AddressableStrip strip(size);
+    strip.setup();
+    strip.light.turn_on().set_brightness(0.8f).perform();
+    strip.loop();
+    AddressableRainbowLightEffect rainbow("Rainbow");
+    rainbow.start();
+    char name[64];
+
+    snprintf(name, sizeof(name), "%d LEDs, to_rgb() + set_rgb() per LED", size);
+    bench(name, 200000 / size, [&](uint32_t i) {
+      uint16_t hue = i * 10;
+      for (auto led : strip.output) {
+        const Color rgb = ESPHSVColor(hue >> 8, 240, 255).to_rgb();
+        led.set_rgb(rgb.r, rgb.g, rgb.b);
+        hue += 0xFFFF / 50;
+      }
+    });
+    // the table as the effect looked it up before set_ramp()
+    std::vector<Color> table(256);
+    for (uint16_t hue = 0; hue < 256; hue++)
+      table[hue] = ESPHSVColor(hue, 240, 255).to_rgb();
+    snprintf(name, sizeof(name), "%d LEDs, hue table + set_rgb() per LED", size);
+    bench(name, 200000 / size, [&](uint32_t i) {
+      uint16_t hue = i * 10;
+      for (auto led : strip.output) {
+        const Color &rgb = table[hue >> 8];
+        led.set_rgb(rgb.r, rgb.g, rgb.b);
+        hue += 0xFFFF / 50;
+      }
+    });
+    snprintf(name, sizeof(name), "%d LEDs, AddressableRainbowLightEffect::apply()", size);
+    bench(name, 200000 / size, [&](uint32_t i) {
+      host::advance_ms(1);
+      rainbow.apply(strip.output, Color::WHITE);
+    });
+  }
+}
+
+TEST_CASE(bench_addressable_power_supply_check) {
+  // the check after every show of a 1000 LED strip: lit pixels are counted as they're written, a dark strip is
+  // counted again in case a pixel was written around the views
+  AddressableStrip strip(1000);
+  strip.setup();
+  strip.light.turn_on().set_brightness(1.0f).perform();
+  strip.loop();
+  strip.output.all() = Color::BLACK;
+  strip.output[999] = Color(0, 0, 255, 0);
+  bench("1000 LEDs, show with one lit pixel", 100000, [&](uint32_t) { strip.show(); });
+  strip.output[999] = Color::BLACK;
+  bench("1000 LEDs, show of a dark strip", 10000, [&](uint32_t) { strip.show(); });
+
+  // what every show cost before: scanning up to the first lit pixel, here the last one
+  strip.output[999] = Color(0, 0, 255, 0);
+  bench("1000 LEDs, scan to the last lit pixel", 10000, [&](uint32_t) {
+    int32_t lit = -1;
+    for (int32_t i = 0; i < 1000 && lit < 0; i++) {
+      if (strip.output[i].get_raw().raw_32 != 0)
+        lit = i;
+    }
+    do_not_optimize(lit);
+  });
+}
+
+TEST_CASE(bench_addressable_range_copy) {
+  // copying 300 pixels within the strip, as shift and wipe effects do
+  AddressableStrip strip(600);
+  strip.setup();
+  strip.light.turn_on().set_brightness(0.8f).perform();
+  strip.loop();
+  fill_gradient(strip.output);
+  bench("300 LEDs, range = range (raw values)", 10000,
+        [&](uint32_t i) { strip.output.range(i % 2 * 300, i % 2 * 300 + 300) = strip.output.range(150, 450); });
+  // what the assignment did before: uncorrect every pixel of the source and correct it again
+  bench("300 LEDs, set(get()) per LED", 10000, [&](uint32_t i) {
+    ESPRangeView dst = strip.output.range(i % 2 * 300, i % 2 * 300 + 300), src = strip.output.range(150, 450);
+    for (int32_t j = 0; j < 300; j++)
+      dst[j].set(src[j].get());
+  });
+}
+
+TEST_CASE(bench_addressable_range_fill) {
+  // filling and walking a 300 pixel range, against going through the light's operator[] for every pixel as the range
+  // views did before
+  AddressableStrip strip(300);
+  strip.setup();
+  strip.light.turn_on().set_brightness(0.8f).perform();
+  strip.loop();
+  AddressableLight &it = opaque(strip.output);
+  ESPRangeView range = it.all();
+  bench("300 LEDs, range = color (corrected once)", 50000,
+        [&](uint32_t i) { range = Color(i, 255 - i, i >> 1, 0); });
+  bench("300 LEDs, it[i] = color per LED", 50000, [&](uint32_t i) {
+    const Color color(i, 255 - i, i >> 1, 0);
+    for (int32_t j = 0; j < 300; j++)
+      it[j] = color;
+  });
+  bench("300 LEDs, for (auto led : range) led.set_red()", 50000, [&](uint32_t i) {
+    for (auto led : range)
+      led.set_red(i);
+  });
+  bench("300 LEDs, it[i].set_red() per LED", 50000, [&](uint32_t i) {
+    for (int32_t j = 0; j < 300; j++)
+      it[j].set_red(i);
+  });
+}
@@ -0,0 +1,83 @@
+#include "esphome/components/light/esp_color_correction.h"
+#include "runner.h"
+
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::light;
+using namespace esphome::testing;
+
+namespace {
+
+/// color_uncorrect() with the 64 bit reciprocals it used before: (n * ceil(2^32 / divisor)) >> 32. The host has a
+/// 64 bit multiplier and vectorizes these, the ESP8266 calls __muldi3 for every one, so only the ESP8266 gains.
+class Uncorrect64 : public ESPColorCorrection {
+ public:
+  void set_brightness(const Color &max_brightness, uint8_t local_brightness) {
+    this->set_max_brightness(max_brightness);
+    this->set_local_brightness(local_brightness);
+    for (uint8_t channel = 0; channel < 4; channel++)
+      this->max_reciprocal64_[channel] = reciprocal64(max_brightness.raw[channel]);
+    this->local_reciprocal64_ = reciprocal64(local_brightness);
+  }
+  Color uncorrect(Color color) const {
+    Color res;
+    for (uint8_t channel = 0; channel < 4; channel++) {
+      const uint32_t uncorrected = this->gamma_reverse_table_[color.raw[channel]] * 255UL;
+      const uint32_t scaled = uint32_t((uncorrected * this->max_reciprocal64_[channel]) >> 32) * 255UL;
+      res.raw[channel] = uint32_t((scaled * this->local_reciprocal64_) >> 32);
+    }
+    return res;
+  }
+
+ protected:
+  static uint64_t reciprocal64(uint8_t divisor) {
+    return divisor == 0 ? 0 : ((uint64_t(1) << 32) + divisor - 1) / divisor;
+  }
+
+  uint64_t max_reciprocal64_[4];
+  uint64_t local_reciprocal64_;
+};
+
+}  // namespace
+
+TEST_CASE(bench_color_uncorrect) {
+  ESPColorCorrection correction;
+  correction.calculate_gamma_table(2.8f);
+  correction.set_max_brightness(Color(255, 200, 150, 255));
+  correction.set_local_brightness(128);
+  bench("ESPColorCorrection::color_uncorrect()", 1000000, [&](uint32_t i) {
+    do_not_optimize(correction.color_uncorrect(Color(i, i >> 8, i >> 16, i >> 3)));
+  });
+  // pixels as color_correct() wrote them, none brighter than the max brightness allows
+  std::vector<Color> corrected(4096);
+  for (uint32_t i = 0; i < corrected.size(); i++)
+    corrected[i] = correction.color_correct(Color(i, i >> 4, i * 7, i >> 2));
+  bench("color_uncorrect() of color_correct() output", 1000000,
+        [&](uint32_t i) { do_not_optimize(correction.color_uncorrect(corrected[i & 4095])); });
+  Uncorrect64 uncorrect64;
+  uncorrect64.calculate_gamma_table(2.8f);
+  uncorrect64.set_brightness(Color(255, 200, 150, 255), 128);
+  bench("the same with 64 bit reciprocals", 1000000,
+        [&](uint32_t i) { do_not_optimize(uncorrect64.uncorrect(corrected[i & 4095])); });
+
+  // addressable lights set the local brightness before every write, it changes on every frame of a transition
+  bench("ESPColorCorrection::set_local_brightness() + color_uncorrect()", 1000000, [&](uint32_t i) {
+    correction.set_local_brightness(i);
+    do_not_optimize(correction.color_uncorrect(Color(i, i >> 8, i >> 16, i >> 3)));
+  });
+}
+
+TEST_CASE(bench_color_correct) {
+  ESPColorCorrection correction;
+  correction.calculate_gamma_table(2.8f);
+  correction.set_local_brightness(128);
+  correction.set_max_brightness(Color(255, 255, 255, 255));
+  bench("color_correct(), same max brightness (all channels at once)", 1000000, [&](uint32_t i) {
+    do_not_optimize(correction.color_correct(Color(i, i >> 8, i >> 16, i >> 3)));
+  });
+  correction.set_max_brightness(Color(255, 200, 150, 255));
+  bench("color_correct(), max brightness per channel", 1000000, [&](uint32_t i) {
+    do_not_optimize(correction.color_correct(Color(i, i >> 8, i >> 16, i >> 3)));
+  });
+}
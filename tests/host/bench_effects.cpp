@@ -0,0 +1,61 @@
+#include "kauf_bulb.h"
+#include "esphome/components/light/base_light_effects.h"
+#include "runner.h"
+
+using namespace esphome;
+using namespace esphome::light;
+using namespace esphome::testing;
+
+namespace {
+
+class RandomProbe : public LightEffect {
+ public:
+  RandomProbe() : LightEffect("Probe") {}
+  void apply() override {}
+  uint32_t draw() { return this->random_uint32_(); }
+};
+
+}  // namespace
+
+TEST_CASE(bench_random_draws) {
+  // On the host random_uint32() is a stand-in, on the ESP8266 it reads the hardware RNG register
+  uint32_t sink = 0;
+  bench("random_uint32() (host stand-in for the hardware RNG)", 10000000, [&](uint32_t) { sink ^= random_uint32(); });
+  RandomProbe probe;
+  probe.set_seed(1);
+  bench("LightEffect::random_uint32_() (xorshift32)", 10000000, [&](uint32_t) { sink ^= probe.draw(); });
+  do_not_optimize(sink);
+}
+
+TEST_CASE(bench_flicker_apply) {
+  KaufBulb bulb("Bench", 0);
+  auto *flicker = new FlickerLightEffect("Flicker");
+  flicker->set_seed(1);
+  bulb.light.add_effects({flicker});
+  bulb.setup();
+  bulb.light.turn_on().set_rgb(1.0f, 0.6f, 0.2f).set_effect("Flicker").perform();
+  bench("FlickerLightEffect::apply()", 200000, [&](uint32_t) { flicker->apply(); });
+}
+
+TEST_CASE(bench_slow_effect_loop) {
+  // a random effect that changes color once an hour, between its updates
+  KaufBulb bulb("Bench", 0);
+  auto *random = new RandomLightEffect("Random");
+  random->set_update_interval(3600000);
+  random->set_transition_length(0);
+  random->set_seed(1);
+  bulb.light.add_effects({random});
+  bulb.setup();
+  bulb.light.turn_on().set_rgb(1.0f, 0.6f, 0.2f).perform();
+  bulb.run_for(100);
+  bench("LightState::loop(), no effect", 1000000, [&](uint32_t) { bulb.light.loop(); });
+
+  bulb.light.turn_on().set_effect("Random").perform();
+  bulb.run_for(100);
+  bench("LightState::loop(), idle slow effect", 1000000, [&](uint32_t) { bulb.light.loop(); });
+  // without the wake-up time the effect's apply() is called on every loop, to find it has nothing to do
+  bench("LightState::loop(), slow effect called every loop", 1000000, [&](uint32_t) {
+    random->clear_wake_time();
+    bulb.light.loop();
+  });
+}
@@ -0,0 +1,208 @@
+#include "dmx_packets.h"
+#include "json_reference.h"
+#include "kauf_bulb.h"
+#include "runner.h"
+
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::light;
+using namespace esphome::testing;
+
+namespace {
+
+/// LightColorValues::lerp() as it was, interpolating every attribute whatever the color mode.
+LightColorValues lerp_every_attribute(const LightColorValues &start, const LightColorValues &end, float completion) {
+  LightColorValues v;
+  v.set_color_mode(end.get_color_mode());
+  v.set_state(esphome::lerp(completion, start.get_state(), end.get_state()));
+  v.set_brightness(esphome::lerp(completion, start.get_brightness(), end.get_brightness()));
+  v.set_color_brightness(esphome::lerp(completion, start.get_color_brightness(), end.get_color_brightness()));
+  v.set_red(esphome::lerp(completion, start.get_red(), end.get_red()));
+  v.set_green(esphome::lerp(completion, start.get_green(), end.get_green()));
+  v.set_blue(esphome::lerp(completion, start.get_blue(), end.get_blue()));
+  v.set_white(esphome::lerp(completion, start.get_white(), end.get_white()));
+  v.set_color_temperature(esphome::lerp(completion, start.get_color_temperature(), end.get_color_temperature()));
+  v.set_cold_white(esphome::lerp(completion, start.get_cold_white(), end.get_cold_white()));
+  v.set_warm_white(esphome::lerp(completion, start.get_warm_white(), end.get_warm_white()));
+  return v;
+}
+
+/// LightColorValues packed to 16 bits per channel, to compare what copying that instead would save.
+struct PackedColorValues {
+  ColorMode color_mode;
+  uint16_t channels[10];
+};
+
+__attribute__((noinline)) float brightness_by_value(LightColorValues values) { return values.get_brightness(); }
+__attribute__((noinline)) float brightness_by_reference(const LightColorValues &values) {
+  return values.get_brightness();
+}
+
+}  // namespace
+
+TEST_CASE(bench_color_values_copy) {
+  // what a copy of the light's values costs, against the reference the hot paths take now and a packed 16 bit copy
+  printf("    sizeof(LightColorValues) %zu, optional<LightColorValues> %zu, packed 16 bit %zu\n",
+         sizeof(LightColorValues), sizeof(optional<LightColorValues>), sizeof(PackedColorValues));
+  LightColorValues values[2];
+  values[0] = LightColorValues(ColorMode::RGB, 1.0f, 0.8f, 1.0f, 1.0f, 0.5f, 0.0f, 0.0f, 250.0f, 0.0f, 0.0f);
+  values[1] = LightColorValues(ColorMode::COLOR_TEMPERATURE, 1.0f, 0.4f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 300.0f, 0.0f,
+                               0.0f);
+  PackedColorValues packed[2] = {{ColorMode::RGB, {65535, 52428, 65535, 65535, 32768}},
+                                 {ColorMode::COLOR_TEMPERATURE, {65535, 26214, 65535, 65535, 65535, 65535}}};
+  bench("LightColorValues copy", 10000000, [&](uint32_t i) {
+    LightColorValues copy = values[i & 1];
+    do_not_optimize(copy);
+  });
+  bench("optional<LightColorValues> copy", 10000000, [&](uint32_t i) {
+    optional<LightColorValues> copy = values[i & 1];
+    do_not_optimize(copy);
+  });
+  bench("16 bit packed copy", 10000000, [&](uint32_t i) {
+    PackedColorValues copy = packed[i & 1];
+    do_not_optimize(copy);
+  });
+  bench("call taking LightColorValues by value", 10000000,
+        [&](uint32_t i) { do_not_optimize(brightness_by_value(values[i & 1])); });
+  bench("call taking const LightColorValues &", 10000000,
+        [&](uint32_t i) { do_not_optimize(brightness_by_reference(values[i & 1])); });
+}
+
+TEST_CASE(bench_write_state) {
+  KaufBulb bulb("Bench", 0);
+  bulb.setup();
+  bulb.light.turn_on().set_color_temperature(250.0f).set_brightness(0.8f).perform();
+  bulb.loop();
+  bench("KaufRGBWWLight::write_state (color temp)", 1000000, [&](uint32_t) { bulb.output.write_state(&bulb.light); });
+
+  bulb.light.turn_on().set_rgb(0.2f, 0.5f, 1.0f).perform();
+  bulb.loop();
+  bench("KaufRGBWWLight::write_state (rgb)", 1000000, [&](uint32_t) { bulb.output.write_state(&bulb.light); });
+}
+
+TEST_CASE(bench_transition_loop) {
+  KaufBulb bulb("Bench", 1000000);
+  bulb.setup();
+  bulb.light.turn_on().set_rgb(1.0f, 0.5f, 0.0f).set_brightness(1.0f).perform();
+  bench("LightState::loop() during a transition", 200000, [&](uint32_t) {
+    host::advance_us(5);
+    bulb.light.loop();
+  });
+}
+
+TEST_CASE(bench_idle_loop) {
+  KaufBulb bulb("Bench", 0);
+  bulb.setup();
+  bulb.run_for(100);
+  bench("LightState::loop() while idle", 1000000, [&](uint32_t) { bulb.light.loop(); });
+}
+
+TEST_CASE(bench_light_call) {
+  KaufBulb bulb("Bench", 0);
+  bulb.setup();
+  bench("LightCall construction + perform()", 200000, [&](uint32_t i) {
+    bulb.light.turn_on().set_brightness((i % 100 + 1) / 100.0f).set_color_temperature(200.0f).perform();
+  });
+}
+
+TEST_CASE(bench_parse_frame) {
+  KaufBulb bulb("Bench", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  const uint8_t frame[13] = {0x41, 0x01, 0x0B, 0x01, 0, 0, 0, 0, 0, 3, 0x20, 0x80, 0xF0};
+  bench("LightState::parse_frame_() (8 bit RGB)", 1000000, [&](uint32_t) { bulb.light.parse_frame_(frame, 13); });
+}
+
+TEST_CASE(bench_parse_dmx) {
+  KaufBulb bulb("Bench", 0);
+  bulb.light.set_e131_universe(1);
+  bulb.light.set_artnet_universe(1);
+  bulb.light.set_dmx_channels(5);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  const auto e131 = dmx::e131_packet(1, dmx::universe_with(1, {32, 128, 240, 10, 20}));
+  const auto artnet = dmx::artnet_packet(1, dmx::universe_with(1, {32, 128, 240, 10, 20}));
+  bench("LightState::parse_e131_() (full universe)", 1000000,
+        [&](uint32_t) { bulb.light.parse_e131_(e131.data(), e131.size()); });
+  bench("LightState::parse_artnet_() (full universe)", 1000000,
+        [&](uint32_t) { bulb.light.parse_artnet_(artnet.data(), artnet.size()); });
+}
+
+TEST_CASE(bench_parse_json) {
+  // a Home Assistant command over MQTT into a LightCall, walking the document once against looking up every key of
+  // the schema
+  KaufBulb bulb("Bench", 0);
+  bulb.setup();
+  DynamicJsonDocument doc(512);
+  deserializeJson(doc, "{\"state\":\"ON\",\"brightness\":200,\"color\":{\"r\":255,\"g\":128,\"b\":0},"
+                       "\"transition\":1}");
+  JsonObject root = doc.as<JsonObject>();
+  bench("LightJSONSchema::parse_json() (rgb command)", 200000, [&](uint32_t) {
+    LightCall call = bulb.light.make_call();
+    LightJSONSchema::parse_json(bulb.light, call, root);
+    do_not_optimize(call);
+  });
+  bench("containsKey() + lookup per key (rgb command)", 200000, [&](uint32_t) {
+    LightCall call = bulb.light.make_call();
+    json::parse_json_by_lookup(bulb.light, call, root);
+    do_not_optimize(call);
+  });
+}
+
+TEST_CASE(bench_receive_packet) {
+  // a packet through the in-memory socket and the read into the packet buffer, then parsed as above
+  host::reset_network();
+  KaufBulb bulb("Bench", 0);
+  bulb.light.set_artnet_universe(1);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  bulb.loop();
+  const auto artnet = dmx::artnet_packet(1, dmx::universe_with(1, {32, 128, 240}));
+  std::vector<uint8_t> ddp(10 + 480 * 3, 0x80);
+  ddp[0] = 0x41;
+  ddp[2] = 0x0B;
+  ddp[3] = 0x01;
+  ddp[8] = (480 * 3) >> 8;
+  ddp[9] = (480 * 3) & 0xFF;
+  bench("host::send_to_port() alone (Art-Net)", 100000, [&](uint32_t) {
+    host::send_to_port(9999, artnet);
+    host::reset_network();
+  });
+  bench("LightState::dmx_apply() (one Art-Net packet)", 100000, [&](uint32_t) {
+    host::send_to_port(6454, artnet);
+    bulb.light.dmx_apply();
+  });
+  bench("LightState::wled_apply() (480 pixel DDP)", 100000, [&](uint32_t) {
+    host::send_to_port(4048, ddp);
+    bulb.light.wled_apply();
+  });
+  host::reset_network();
+}
+
+TEST_CASE(bench_lerp_per_color_mode) {
+  const std::pair<const char *, ColorMode> modes[] = {
+      {"BRIGHTNESS", ColorMode::BRIGHTNESS},
+      {"RGB", ColorMode::RGB},
+      {"COLOR_TEMPERATURE", ColorMode::COLOR_TEMPERATURE},
+      {"COLD_WARM_WHITE", ColorMode::COLD_WARM_WHITE},
+      {"RGB_WHITE", ColorMode::RGB_WHITE},
+      {"RGB_COLD_WARM_WHITE", ColorMode::RGB_COLD_WARM_WHITE},
+      {"UNKNOWN (everything)", ColorMode::UNKNOWN},
+  };
+  for (const auto &mode : modes) {
+    const LightColorValues start(mode.second, 1.0f, 0.2f, 0.3f, 1.0f, 0.0f, 0.5f, 0.1f, 200.0f, 0.0f, 1.0f);
+    const LightColorValues end(mode.second, 1.0f, 0.9f, 1.0f, 0.0f, 1.0f, 0.2f, 0.8f, 400.0f, 1.0f, 0.3f);
+    char name[64];
+    snprintf(name, sizeof(name), "lerp() %s", mode.first);
+    bench(name, 1000000, [&](uint32_t i) {
+      do_not_optimize(LightColorValues::lerp(start, end, (i & 1023) / 1023.0f));
+    });
+    snprintf(name, sizeof(name), "lerp() %s, every attribute", mode.first);
+    bench(name, 1000000, [&](uint32_t i) {
+      do_not_optimize(lerp_every_attribute(start, end, (i & 1023) / 1023.0f));
+    });
+  }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace esphome {
+namespace testing {
+namespace dmx {
+
+/// E1.31 data packet for the universe with the DMX channels from 1 on, as a sACN source sends it.
+inline std::vector<uint8_t> e131_packet(uint16_t universe, const std::vector<uint8_t> &dmx, uint8_t options = 0,
+                                        uint8_t start_code = 0) {
+  std::vector<uint8_t> p(126 + dmx.size());
+  p[1] = 0x10;
+  const char acn_id[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+  memcpy(&p[4], acn_id, sizeof(acn_id));
+  p[21] = 0x04;  // root vector: data
+  p[43] = 0x02;  // framing vector: DMP data
+  p[112] = options;
+  p[113] = universe >> 8;
+  p[114] = universe & 0xFF;
+  const uint16_t count = dmx.size() + 1;
+  p[123] = count >> 8;
+  p[124] = count & 0xFF;
+  p[125] = start_code;
+  memcpy(&p[126], dmx.data(), dmx.size());
+  return p;
+}
+
+/// ArtDmx packet for the 15 bit port address with the DMX channels from 1 on.
+inline std::vector<uint8_t> artnet_packet(uint16_t universe, const std::vector<uint8_t> &dmx,
+                                          uint16_t opcode = 0x5000) {
+  std::vector<uint8_t> p(18 + dmx.size());
+  memcpy(&p[0], "Art-Net", 8);
+  p[8] = opcode & 0xFF;
+  p[9] = opcode >> 8;
+  p[11] = 14;  // protocol version
+  p[14] = universe & 0xFF;
+  p[15] = universe >> 8;
+  p[16] = dmx.size() >> 8;
+  p[17] = dmx.size() & 0xFF;
+  memcpy(&p[18], dmx.data(), dmx.size());
+  return p;
+}
+
+/// A full universe of 512 channels, the levels from the start channel on and the rest 0.
+inline std::vector<uint8_t> universe_with(uint16_t start_channel, const std::vector<uint8_t> &levels) {
+  std::vector<uint8_t> dmx(512);
+  std::copy(levels.begin(), levels.end(), dmx.begin() + start_channel - 1);
+  return dmx;
+}
+
+}  // namespace dmx
+}  // namespace testing
+}  // namespace esphome
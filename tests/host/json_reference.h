@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cmath>
+
+#include "esphome/components/light/light_json_schema.h"
+
+namespace esphome {
+namespace testing {
+namespace json {
+
+/// LightJSONSchema::parse_json() as it was before it walked the document once, probing every key of the schema with
+/// containsKey() and looking it up again. Non-string "state" and "effect" values are skipped as parse_json() now does,
+/// it crashed on those.
+inline void parse_json_by_lookup(light::LightState &state, light::LightCall &call, JsonObject root) {
+  if (root.containsKey("state")) {
+    const char *state_str = root["state"];
+    if (state_str != nullptr) {
+      switch (parse_on_off(state_str)) {
+        case PARSE_ON:
+          call.set_state(true);
+          break;
+        case PARSE_OFF:
+          call.set_state(false);
+          break;
+        case PARSE_TOGGLE:
+          call.set_state(!state.remote_values.is_on());
+          break;
+        case PARSE_NONE:
+          break;
+      }
+    }
+  }
+  if (root.containsKey("brightness"))
+    call.set_brightness(float(root["brightness"]) / 255.0f);
+  if (root.containsKey("color")) {
+    JsonObject color = root["color"];
+    float max_rgb = 0.0f;
+    if (color.containsKey("r")) {
+      float r = float(color["r"]) / 255.0f;
+      max_rgb = fmaxf(max_rgb, r);
+      call.set_red(r);
+    }
+    if (color.containsKey("g")) {
+      float g = float(color["g"]) / 255.0f;
+      max_rgb = fmaxf(max_rgb, g);
+      call.set_green(g);
+    }
+    if (color.containsKey("b")) {
+      float b = float(color["b"]) / 255.0f;
+      max_rgb = fmaxf(max_rgb, b);
+      call.set_blue(b);
+    }
+    if (color.containsKey("r") || color.containsKey("g") || color.containsKey("b"))
+      call.set_color_brightness(max_rgb);
+    if (color.containsKey("c"))
+      call.set_cold_white(float(color["c"]) / 255.0f);
+    if (color.containsKey("w")) {
+      if (color.containsKey("c")) {
+        call.set_warm_white(float(color["w"]) / 255.0f);
+      } else {
+        call.set_white(float(color["w"]) / 255.0f);
+      }
+    }
+  }
+  if (root.containsKey("white_value"))
+    call.set_white(float(root["white_value"]) / 255.0f);
+  if (root.containsKey("color_temp"))
+    call.set_color_temperature(float(root["color_temp"]));
+  if (root.containsKey("flash"))
+    call.set_flash_length(uint32_t(float(root["flash"]) * 1000));
+  if (root.containsKey("transition"))
+    call.set_transition_length(uint32_t(float(root["transition"]) * 1000));
+  if (root.containsKey("effect")) {
+    const char *effect = root["effect"];
+    if (effect != nullptr)
+      call.set_effect(effect);
+  }
+}
+
+}  // namespace json
+}  // namespace testing
+}  // namespace esphome
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "esphome/components/kauf_rgbww/kauf_rgbww.h"
+#include "esphome/components/light/light_state.h"
+#include "esphome/components/output/float_output.h"
+#include "host.h"
+
+namespace esphome {
+namespace testing {
+
+/// A bulb wired up like kauf-bulb.yaml: the main RGBWW light on five PWM outputs, plus its Warm RGB and Cold RGB
+/// aux lights.
+struct KaufBulb {
+  output::FloatOutput red, green, blue, cold_white, warm_white;
+  kauf_rgbww::KaufRGBWWLight warm_rgb_output, cold_rgb_output, output;
+  light::LightState warm_rgb{&warm_rgb_output};
+  light::LightState cold_rgb{&cold_rgb_output};
+  light::LightState light{&output};
+
+  explicit KaufBulb(const char *name = "Bulb", uint32_t transition_ms = 1000) {
+    this->warm_rgb.set_name("Warm RGB");
+    this->cold_rgb.set_name("Cold RGB");
+    this->light.set_name(name);
+    this->warm_rgb.set_default_transition_length(0);
+    this->cold_rgb.set_default_transition_length(0);
+    this->light.set_default_transition_length(transition_ms);
+    for (auto *state : {&this->warm_rgb, &this->cold_rgb, &this->light})
+      state->set_restore_mode(light::LIGHT_ALWAYS_OFF);
+
+    this->output.set_warm_rgb(&this->warm_rgb);
+    this->output.set_cold_rgb(&this->cold_rgb);
+    this->output.set_aux(false);
+    this->output.set_red(&this->red);
+    this->output.set_green(&this->green);
+    this->output.set_blue(&this->blue);
+    this->output.set_cold_white(&this->cold_white);
+    this->output.set_warm_white(&this->warm_white);
+  }
+
+  void setup() {
+    this->warm_rgb.setup();
+    this->cold_rgb.setup();
+    this->light.setup();
+    this->loop();
+  }
+
+  /// One iteration of the component loop, in the order ESPHome registers the lights. The output is only a
+  /// component with DDP followers, and its loop does nothing without them.
+  void loop() {
+    this->warm_rgb.loop();
+    this->cold_rgb.loop();
+    this->light.loop();
+    this->output.loop();
+  }
+
+  /// Run the loop every interval_ms on the simulated clock for duration_ms.
+  void run_for(uint32_t duration_ms, uint32_t interval_ms = 16) {
+    for (uint32_t t = 0; t < duration_ms; t += interval_ms) {
+      host::advance_ms(interval_ms);
+      this->loop();
+    }
+  }
+
+  void levels(float out[5]) const {
+    out[0] = this->red.get_level();
+    out[1] = this->green.get_level();
+    out[2] = this->blue.get_level();
+    out[3] = this->cold_white.get_level();
+    out[4] = this->warm_white.get_level();
+  }
+};
+
+}  // namespace testing
+}  // namespace esphome
@@ -0,0 +1,52 @@
+#include <cstring>
+#include <vector>
+
+#include "runner.h"
+
+namespace esphome {
+namespace testing {
+
+struct Case {
+  const char *name;
+  CaseFunction function;
+};
+
+static std::vector<Case> &cases() {
+  static std::vector<Case> registered;
+  return registered;
+}
+
+static int case_failures = 0;  // NOLINT
+
+CaseRegistration::CaseRegistration(const char *name, CaseFunction function) { cases().push_back({name, function}); }
+
+void fail(const char *file, int line, const char *message) {
+  printf("    %s:%d: %s\n", file, line, message);
+  case_failures++;
+}
+
+}  // namespace testing
+}  // namespace esphome
+
+int main(int argc, char **argv) {
+  using namespace esphome::testing;
+  const char *filter = argc > 1 ? argv[1] : nullptr;
+
+  int run = 0;
+  int failed = 0;
+  for (const Case &c : cases()) {
+    if (filter != nullptr && strstr(c.name, filter) == nullptr)
+      continue;
+    printf("%s\n", c.name);
+    case_failures = 0;
+    c.function();
+    run++;
+    if (case_failures > 0) {
+      printf("  FAILED (%d)\n", case_failures);
+      failed++;
+    }
+  }
+
+  printf("%d of %d cases passed\n", run - failed, run);
+  return failed == 0 ? 0 : 1;
+}
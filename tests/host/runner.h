@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+// Minimal test and benchmark runner of the host build. Cases register themselves at static initialization, the
+// runner's main() runs them all (or those whose name contains the first argument) and reports the failures.
+
+namespace esphome {
+namespace testing {
+
+using CaseFunction = void (*)();
+
+struct CaseRegistration {
+  CaseRegistration(const char *name, CaseFunction function);
+};
+
+/// Record a failed check of the running case.
+void fail(const char *file, int line, const char *message);
+
+/// Run f for the given number of iterations and report the mean time per iteration.
+template<typename F> double bench(const char *name, uint32_t iterations, F &&f) {
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; i++)
+    f(i);
+  const auto end = std::chrono::steady_clock::now();
+  const double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+  printf("  %-48s %10.1f ns/op\n", name, ns);
+  return ns;
+}
+
+/// Keep the compiler from optimizing away a benchmarked result.
+template<typename T> void do_not_optimize(const T &value) { asm volatile("" : : "r,m"(value) : "memory"); }
+
+}  // namespace testing
+}  // namespace esphome
+
+#define TEST_CASE(name) \
+  static void name(); \
+  static ::esphome::testing::CaseRegistration name##_registration(#name, name); \
+  static void name()
+
+#define EXPECT_TRUE(condition) \
+  do { \
+    if (!(condition)) \
+      ::esphome::testing::fail(__FILE__, __LINE__, "expected " #condition); \
+  } while (0)
+
+#define EXPECT_EQ(actual, expected) \
+  do { \
+    if (!((actual) == (expected))) \
+      ::esphome::testing::fail(__FILE__, __LINE__, "expected " #actual " == " #expected); \
+  } while (0)
+
+#define EXPECT_NEAR(actual, expected, tolerance) \
+  do { \
+    if (!(std::fabs(double(actual) - double(expected)) <= (tolerance))) { \
+      char message[256]; \
+      snprintf(message, sizeof(message), "expected " #actual " = %g to be within %g of %g", double(actual), \
+               double(tolerance), double(expected)); \
+      ::esphome::testing::fail(__FILE__, __LINE__, message); \
+    } \
+  } while (0)
@@ -0,0 +1,425 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// The part of ArduinoJson 6 that the light component and its host tests use: a document of objects, arrays, strings,
+// numbers and booleans, the JsonObject / JsonVariant views on it, and deserializeJson() / serializeJson(). Lookups
+// and conversions behave like the library's, a missing member or a value of another type converts to 0 / nullptr /
+// a null object.
+
+namespace ArduinoJson {
+
+class JsonDocument;
+class JsonObject;
+
+namespace detail {
+
+struct Node {
+  enum Type { NUL, BOOLEAN, NUMBER, STRING, OBJECT, ARRAY } type{NUL};
+  double number{0.0};
+  std::string string;
+  /// Members of an object in document order, the elements of an array have an empty key.
+  std::vector<std::pair<std::string, Node *>> members;
+  JsonDocument *doc{nullptr};
+
+  Node *find(const char *key) const {
+    for (const auto &member : this->members) {
+      if (member.first == key)
+        return member.second;
+    }
+    return nullptr;
+  }
+  Node *add(const char *key);
+};
+
+}  // namespace detail
+
+class JsonString {
+ public:
+  explicit JsonString(const char *str) : str_(str) {}
+  const char *c_str() const { return this->str_; }
+
+ protected:
+  const char *str_;
+};
+
+class JsonVariant {
+ public:
+  JsonVariant() = default;
+  explicit JsonVariant(detail::Node *node) : node_(node) {}
+
+  bool isNull() const { return this->node_ == nullptr || this->node_->type == detail::Node::NUL; }
+
+  template<typename T> typename std::enable_if<std::is_arithmetic<T>::value, T>::type as() const {
+    if (this->node_ == nullptr)
+      return T(0);
+    if (this->node_->type != detail::Node::NUMBER && this->node_->type != detail::Node::BOOLEAN)
+      return T(0);
+    return T(this->node_->number);
+  }
+  template<typename T> typename std::enable_if<std::is_same<T, const char *>::value, T>::type as() const {
+    if (this->node_ == nullptr || this->node_->type != detail::Node::STRING)
+      return nullptr;
+    return this->node_->string.c_str();
+  }
+  template<typename T> typename std::enable_if<std::is_same<T, JsonObject>::value, T>::type as() const;
+
+  template<typename T> operator T() const { return this->as<T>(); }
+
+ protected:
+  detail::Node *node_{nullptr};
+};
+
+/// What JsonObject::operator[] returns: reads like a JsonVariant of the member, assigning to it adds the member.
+class MemberProxy {
+ public:
+  MemberProxy(detail::Node *object, const char *key) : object_(object), key_(key) {}
+
+  bool isNull() const { return this->variant_().isNull(); }
+  template<typename T> T as() const { return this->variant_().template as<T>(); }
+  template<typename T> operator T() const { return this->as<T>(); }
+
+  MemberProxy &operator=(const char *value) {
+    detail::Node *node = this->node_();
+    node->type = detail::Node::STRING;
+    node->string = value;
+    return *this;
+  }
+  MemberProxy &operator=(bool value) {
+    detail::Node *node = this->node_();
+    node->type = detail::Node::BOOLEAN;
+    node->number = value ? 1.0 : 0.0;
+    return *this;
+  }
+  template<typename T> typename std::enable_if<std::is_arithmetic<T>::value, MemberProxy &>::type operator=(T value) {
+    detail::Node *node = this->node_();
+    node->type = detail::Node::NUMBER;
+    node->number = double(value);
+    return *this;
+  }
+
+ protected:
+  JsonVariant variant_() const {
+    return JsonVariant(this->object_ == nullptr ? nullptr : this->object_->find(this->key_));
+  }
+  detail::Node *node_() {
+    detail::Node *node = this->object_->find(this->key_);
+    return node != nullptr ? node : this->object_->add(this->key_);
+  }
+
+  detail::Node *object_;
+  const char *key_;
+};
+
+class JsonPair {
+ public:
+  JsonPair(const std::pair<std::string, detail::Node *> &member) : member_(&member) {}
+  JsonString key() const { return JsonString(this->member_->first.c_str()); }
+  JsonVariant value() const { return JsonVariant(this->member_->second); }
+
+ protected:
+  const std::pair<std::string, detail::Node *> *member_;
+};
+
+class JsonObject {
+ public:
+  using member_iterator = std::vector<std::pair<std::string, detail::Node *>>::const_iterator;
+
+  class iterator {
+   public:
+    explicit iterator(member_iterator it) : it_(it) {}
+    JsonPair operator*() const { return JsonPair(*this->it_); }
+    iterator &operator++() {
+      ++this->it_;
+      return *this;
+    }
+    bool operator!=(const iterator &other) const { return this->it_ != other.it_; }
+
+   protected:
+    member_iterator it_;
+  };
+
+  JsonObject() = default;
+  explicit JsonObject(detail::Node *node)
+      : node_(node != nullptr && node->type == detail::Node::OBJECT ? node : nullptr) {}
+
+  bool isNull() const { return this->node_ == nullptr; }
+  size_t size() const { return this->node_ == nullptr ? 0 : this->node_->members.size(); }
+  bool containsKey(const char *key) const { return this->node_ != nullptr && this->node_->find(key) != nullptr; }
+  MemberProxy operator[](const char *key) const { return MemberProxy(this->node_, key); }
+  JsonObject createNestedObject(const char *key) const {
+    if (this->node_ == nullptr)
+      return JsonObject();
+    detail::Node *node = this->node_->add(key);
+    node->type = detail::Node::OBJECT;
+    return JsonObject(node);
+  }
+
+  iterator begin() const {
+    return iterator(this->node_ == nullptr ? member_iterator() : this->node_->members.begin());
+  }
+  iterator end() const { return iterator(this->node_ == nullptr ? member_iterator() : this->node_->members.end()); }
+
+ protected:
+  friend void serializeJson(JsonObject object, std::string &output);
+
+  detail::Node *node_{nullptr};
+};
+
+template<typename T> typename std::enable_if<std::is_same<T, JsonObject>::value, T>::type JsonVariant::as() const {
+  return JsonObject(this->node_);
+}
+
+class JsonDocument {
+ public:
+  JsonDocument() = default;
+  JsonDocument(const JsonDocument &) = delete;
+  JsonDocument &operator=(const JsonDocument &) = delete;
+
+  /// Drop the contents and make the root an empty object.
+  template<typename T> typename std::enable_if<std::is_same<T, JsonObject>::value, T>::type to() {
+    this->clear();
+    this->root_()->type = detail::Node::OBJECT;
+    return JsonObject(this->root_());
+  }
+  template<typename T> T as() { return JsonVariant(this->root_()).template as<T>(); }
+  void clear() { this->nodes_.clear(); }
+
+  detail::Node *new_node() {
+    this->nodes_.emplace_back();
+    this->nodes_.back().doc = this;
+    return &this->nodes_.back();
+  }
+
+ protected:
+  detail::Node *root_() { return this->nodes_.empty() ? this->new_node() : &this->nodes_.front(); }
+
+  std::deque<detail::Node> nodes_;
+};
+
+/// The capacity only matters on the devices, here the document grows as needed.
+class DynamicJsonDocument : public JsonDocument {
+ public:
+  explicit DynamicJsonDocument(size_t capacity) {}
+};
+
+inline detail::Node *detail::Node::add(const char *key) {
+  Node *node = this->doc->new_node();
+  this->members.emplace_back(key, node);
+  return node;
+}
+
+class DeserializationError {
+ public:
+  enum Code { Ok, InvalidInput, IncompleteInput };
+
+  DeserializationError(Code code) : code_(code) {}
+  explicit operator bool() const { return this->code_ != Ok; }
+  const char *c_str() const {
+    return this->code_ == Ok ? "Ok" : this->code_ == InvalidInput ? "InvalidInput" : "IncompleteInput";
+  }
+
+ protected:
+  Code code_;
+};
+
+namespace detail {
+
+class Parser {
+ public:
+  Parser(JsonDocument &doc, const char *input) : doc_(doc), p_(input) {}
+
+  DeserializationError::Code parse(Node *node) {
+    this->skip_space_();
+    switch (*this->p_) {
+      case '\0':
+        return DeserializationError::IncompleteInput;
+      case '{':
+        return this->parse_members_(node, Node::OBJECT, '}');
+      case '[':
+        return this->parse_members_(node, Node::ARRAY, ']');
+      case '"':
+        node->type = Node::STRING;
+        return this->parse_string_(node->string);
+      case 't':
+        node->type = Node::BOOLEAN;
+        node->number = 1.0;
+        return this->literal_("true");
+      case 'f':
+        node->type = Node::BOOLEAN;
+        return this->literal_("false");
+      case 'n':
+        return this->literal_("null");
+      default: {
+        char *end;
+        node->number = strtod(this->p_, &end);
+        if (end == this->p_)
+          return DeserializationError::InvalidInput;
+        node->type = Node::NUMBER;
+        this->p_ = end;
+        return DeserializationError::Ok;
+      }
+    }
+  }
+
+ protected:
+  void skip_space_() {
+    while (*this->p_ == ' ' || *this->p_ == '\t' || *this->p_ == '\n' || *this->p_ == '\r')
+      this->p_++;
+  }
+
+  DeserializationError::Code literal_(const char *literal) {
+    const size_t length = strlen(literal);
+    if (strncmp(this->p_, literal, length) != 0)
+      return DeserializationError::InvalidInput;
+    this->p_ += length;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parse_string_(std::string &out) {
+    this->p_++;  // opening quote
+    while (*this->p_ != '"') {
+      if (*this->p_ == '\0')
+        return DeserializationError::IncompleteInput;
+      if (*this->p_ == '\\') {
+        this->p_++;
+        switch (*this->p_) {
+          case 'n':
+            out += '\n';
+            break;
+          case 't':
+            out += '\t';
+            break;
+          case '\0':
+            return DeserializationError::IncompleteInput;
+          default:
+            out += *this->p_;
+            break;
+        }
+      } else {
+        out += *this->p_;
+      }
+      this->p_++;
+    }
+    this->p_++;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parse_members_(Node *node, Node::Type type, char close) {
+    node->type = type;
+    this->p_++;
+    this->skip_space_();
+    if (*this->p_ == close) {
+      this->p_++;
+      return DeserializationError::Ok;
+    }
+    while (true) {
+      std::string key;
+      if (type == Node::OBJECT) {
+        this->skip_space_();
+        if (*this->p_ != '"')
+          return *this->p_ == '\0' ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+        DeserializationError::Code code = this->parse_string_(key);
+        if (code != DeserializationError::Ok)
+          return code;
+        this->skip_space_();
+        if (*this->p_ != ':')
+          return *this->p_ == '\0' ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+        this->p_++;
+      }
+      Node *value = this->doc_.new_node();
+      node->members.emplace_back(std::move(key), value);
+      DeserializationError::Code code = this->parse(value);
+      if (code != DeserializationError::Ok)
+        return code;
+      this->skip_space_();
+      if (*this->p_ == close) {
+        this->p_++;
+        return DeserializationError::Ok;
+      }
+      if (*this->p_ != ',')
+        return *this->p_ == '\0' ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+      this->p_++;
+    }
+  }
+
+  JsonDocument &doc_;
+  const char *p_;
+};
+
+}  // namespace detail
+
+inline DeserializationError deserializeJson(JsonDocument &doc, const char *input) {
+  doc.clear();
+  detail::Node *root = doc.new_node();
+  return detail::Parser(doc, input).parse(root);
+}
+inline DeserializationError deserializeJson(JsonDocument &doc, const std::string &input) {
+  return deserializeJson(doc, input.c_str());
+}
+
+namespace detail {
+
+inline void serialize(const Node *node, std::string &output) {
+  switch (node->type) {
+    case Node::NUL:
+      output += "null";
+      break;
+    case Node::BOOLEAN:
+      output += node->number != 0.0 ? "true" : "false";
+      break;
+    case Node::NUMBER: {
+      char buffer[32];
+      snprintf(buffer, sizeof(buffer), "%.9g", node->number);
+      output += buffer;
+      break;
+    }
+    case Node::STRING:
+      output += '"';
+      for (char c : node->string) {
+        if (c == '"' || c == '\\')
+          output += '\\';
+        output += c;
+      }
+      output += '"';
+      break;
+    case Node::OBJECT:
+    case Node::ARRAY:
+      output += node->type == Node::OBJECT ? '{' : '[';
+      for (size_t i = 0; i < node->members.size(); i++) {
+        if (i > 0)
+          output += ',';
+        if (node->type == Node::OBJECT) {
+          output += '"';
+          output += node->members[i].first;
+          output += "\":";
+        }
+        serialize(node->members[i].second, output);
+      }
+      output += node->type == Node::OBJECT ? '}' : ']';
+      break;
+  }
+}
+
+}  // namespace detail
+
+inline void serializeJson(JsonObject object, std::string &output) {
+  output.clear();
+  if (object.node_ == nullptr) {
+    output = "null";
+    return;
+  }
+  detail::serialize(object.node_, output);
+}
+
+}  // namespace ArduinoJson
+
+using namespace ArduinoJson;
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "IPAddress.h"
+
+// WiFi station of the host test build, connected or not as a test sets it through host.h.
+class ESP8266WiFiClass {
+ public:
+  IPAddress localIP();
+  bool isConnected();
+};
+
+extern ESP8266WiFiClass WiFi;  // NOLINT
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Arduino's IPAddress, IPv4 only.
+class IPAddress {
+ public:
+  IPAddress() : bytes_{0, 0, 0, 0} {}
+  IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth) : bytes_{first, second, third, fourth} {}
+
+  uint8_t operator[](int index) const { return this->bytes_[index]; }
+  uint8_t &operator[](int index) { return this->bytes_[index]; }
+  bool operator==(const IPAddress &other) const {
+    return this->bytes_[0] == other.bytes_[0] && this->bytes_[1] == other.bytes_[1] &&
+           this->bytes_[2] == other.bytes_[2] && this->bytes_[3] == other.bytes_[3];
+  }
+  bool operator!=(const IPAddress &other) const { return !(*this == other); }
+  bool isSet() const { return *this != IPAddress(); }
+
+  std::string toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", this->bytes_[0], this->bytes_[1], this->bytes_[2], this->bytes_[3]);
+    return buf;
+  }
+
+ protected:
+  uint8_t bytes_[4];
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "IPAddress.h"
+
+// Arduino WiFiUDP on the in-memory network of the host test build (see host.h). Packets a test sends to a port or
+// multicast group are queued at every socket bound to it, and everything written is recorded instead of sent.
+class WiFiUDP {
+ public:
+  WiFiUDP();
+  ~WiFiUDP();
+  WiFiUDP(const WiFiUDP &) = delete;
+  WiFiUDP &operator=(const WiFiUDP &) = delete;
+
+  uint8_t begin(uint16_t port);
+  uint8_t beginMulticast(IPAddress interface_addr, IPAddress multicast, uint16_t port);
+  void stop();
+
+  int parsePacket();
+  int read(uint8_t *buffer, size_t len);
+
+  int beginPacket(const char *host, uint16_t port);
+  int beginPacket(IPAddress ip, uint16_t port);
+  size_t write(uint8_t byte);
+  size_t write(const uint8_t *buffer, size_t size);
+  int endPacket();
+
+  // state of the simulated socket, used by the host network
+  uint16_t port_{0};
+  /// Local address when the socket was bound, so a test can run several hosts in one network.
+  IPAddress local_ip_;
+  bool multicast_{false};
+  IPAddress group_;
+  std::deque<std::vector<uint8_t>> rx_;
+  std::vector<uint8_t> current_;
+  std::string tx_host_;
+  uint16_t tx_port_{0};
+  std::vector<uint8_t> tx_;
+  bool tx_open_{false};
+};
@@ -0,0 +1,4 @@
+#pragma once
+
+// ESPHome's json component only for the ArduinoJson types, the light component doesn't use its helpers.
+#include "ArduinoJson.h"
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+namespace esphome {
+namespace output {
+
+// Float output of the host test build, it keeps the last level and optionally a history of all written levels.
+class FloatOutput {
+ public:
+  virtual ~FloatOutput() = default;
+
+  void set_level(float state) {
+    this->level_ = state;
+    this->writes_++;
+    if (this->record_)
+      this->history_.push_back(state);
+  }
+  float get_level() const { return this->level_; }
+  uint32_t get_writes() const { return this->writes_; }
+
+  void set_record(bool record) { this->record_ = record; }
+  const std::vector<float> &get_history() const { return this->history_; }
+
+ protected:
+  float level_{0.0f};
+  uint32_t writes_{0};
+  bool record_{false};
+  std::vector<float> history_;
+};
+
+}  // namespace output
+}  // namespace esphome
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace power_supply {
+
+// Power supply of the host test build, it only counts the requests instead of switching a pin.
+class PowerSupply : public Component {
+ public:
+  bool is_enabled() const { return this->active_requests_ > 0; }
+  void request_high_power() { this->active_requests_++; }
+  void unrequest_high_power() { this->active_requests_--; }
+
+ protected:
+  int16_t active_requests_{0};
+};
+
+class PowerSupplyRequester {
+ public:
+  void set_parent(PowerSupply *parent) { this->parent_ = parent; }
+  void request() {
+    if (!this->requested_ && this->parent_ != nullptr) {
+      this->parent_->request_high_power();
+      this->requested_ = true;
+    }
+  }
+  void unrequest() {
+    if (this->requested_ && this->parent_ != nullptr) {
+      this->parent_->unrequest_high_power();
+      this->requested_ = false;
+    }
+  }
+
+ protected:
+  PowerSupply *parent_{nullptr};
+  bool requested_{false};
+};
+
+}  // namespace power_supply
+}  // namespace esphome
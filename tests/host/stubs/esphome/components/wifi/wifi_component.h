@@ -0,0 +1,24 @@
+#pragma once
+
+#include <arpa/inet.h>
+
+#include "esphome/components/network/ip_address.h"
+
+// lwIP's accessor for the last octet, for the in_addr based network::IPAddress of the host platform
+#ifndef ip4_addr4_val
+#define ip4_addr4_val(ipaddr) (uint8_t(ntohl((ipaddr).s_addr) & 0xFF))
+#endif
+
+namespace esphome {
+namespace wifi {
+
+class WiFiComponent {
+ public:
+  bool is_connected();
+  network::IPAddresses get_ip_addresses();
+};
+
+extern WiFiComponent *global_wifi_component;  // NOLINT
+
+}  // namespace wifi
+}  // namespace esphome
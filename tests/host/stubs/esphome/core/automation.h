@@ -0,0 +1,105 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+
+// The automation classes of ESPHome's core/automation.h, reduced to direct calls without action chaining.
+
+#define TEMPLATABLE_VALUE_(type, name) \
+ protected: \
+  TemplatableValue<type, Ts...> name##_{}; \
+\
+ public: \
+  template<typename V> void set_##name(V name) { this->name##_ = name; }
+
+#define TEMPLATABLE_VALUE(type, name) TEMPLATABLE_VALUE_(type, name)
+
+template<typename T, typename... X> class TemplatableValue {
+ public:
+  TemplatableValue() : type_(NONE) {}
+
+  template<typename F, typename std::enable_if<!std::is_invocable<F, X...>::value, int>::type = 0>
+  TemplatableValue(F value) : type_(VALUE), value_(value) {}  // NOLINT
+
+  template<typename F, typename std::enable_if<std::is_invocable<F, X...>::value, int>::type = 0>
+  TemplatableValue(F f) : type_(LAMBDA), f_(f) {}  // NOLINT
+
+  bool has_value() const { return this->type_ != NONE; }
+
+  T value(X... x) {
+    if (this->type_ == LAMBDA)
+      return this->f_(x...);
+    return this->value_;
+  }
+
+  optional<T> optional_value(X... x) {
+    if (!this->has_value())
+      return {};
+    return this->value(x...);
+  }
+
+  T value_or(X... x, T default_value) {
+    if (!this->has_value())
+      return default_value;
+    return this->value(x...);
+  }
+
+ protected:
+  enum { NONE, VALUE, LAMBDA } type_;
+  T value_{};
+  std::function<T(X...)> f_;
+};
+
+template<typename... Ts> class Condition {
+ public:
+  virtual ~Condition() = default;
+  virtual bool check(Ts... x) = 0;
+};
+
+template<typename... Ts> class Automation;
+
+template<typename... Ts> class Trigger {
+ public:
+  void trigger(Ts... x) {
+    for (auto &cb : this->callbacks_)
+      cb(x...);
+  }
+  void add_on_trigger_callback(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(callback); }
+  void set_automation_parent(Automation<Ts...> *automation_parent) {}
+  void stop_action() {}
+  bool is_action_running() { return false; }
+
+ protected:
+  std::vector<std::function<void(Ts...)>> callbacks_;
+};
+
+template<typename... Ts> class Action {
+ public:
+  virtual ~Action() = default;
+  virtual void play_complex(Ts... x) { this->play(x...); }
+  virtual void stop_complex() { this->stop(); }
+  virtual bool is_running() { return false; }
+
+ protected:
+  virtual void play(Ts... x) = 0;
+  virtual void stop() {}
+};
+
+template<typename T> class Parented {
+ public:
+  Parented() {}
+  Parented(T *parent) : parent_(parent) {}  // NOLINT
+  T *get_parent() const { return parent_; }
+  void set_parent(T *parent) { parent_ = parent; }
+
+ protected:
+  T *parent_{nullptr};
+};
+
+}  // namespace esphome
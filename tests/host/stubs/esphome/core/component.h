@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "esphome/core/optional.h"
+
+namespace esphome {
+
+namespace setup_priority {
+
+extern const float BUS;
+extern const float IO;
+extern const float HARDWARE;
+extern const float DATA;
+extern const float PROCESSOR;
+extern const float WIFI;
+extern const float AFTER_WIFI;
+extern const float AFTER_CONNECTION;
+extern const float LATE;
+
+}  // namespace setup_priority
+
+class Component {
+ public:
+  virtual ~Component() = default;
+
+  virtual void setup() {}
+  virtual void loop() {}
+  virtual void dump_config() {}
+  virtual float get_setup_priority() const;
+  virtual float get_loop_priority() const { return 0.0f; }
+  virtual void on_shutdown() {}
+  virtual void on_safe_shutdown() {}
+
+  virtual void call_setup() { this->setup(); }
+  virtual void call_loop() { this->loop(); }
+  virtual void call_dump_config() { this->dump_config(); }
+
+  void mark_failed() { this->failed_ = true; }
+  bool is_failed() const { return this->failed_; }
+  void status_set_warning(const char *message = "unspecified") {}
+  void status_clear_warning() {}
+
+ protected:
+  // the host build has no scheduler, timeouts and intervals are never run
+  void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {}
+  void set_timeout(uint32_t timeout, std::function<void()> &&f) {}
+  bool cancel_timeout(const std::string &name) { return false; }
+  void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f) {}
+  void set_interval(uint32_t interval, std::function<void()> &&f) {}
+  bool cancel_interval(const std::string &name) { return false; }
+
+  bool failed_{false};
+};
+
+class PollingComponent : public Component {
+ public:
+  PollingComponent() : PollingComponent(0) {}
+  explicit PollingComponent(uint32_t update_interval) : update_interval_(update_interval) {}
+  virtual void update() = 0;
+  void set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
+  uint32_t get_update_interval() const { return this->update_interval_; }
+
+ protected:
+  uint32_t update_interval_;
+};
+
+}  // namespace esphome
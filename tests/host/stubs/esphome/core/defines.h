@@ -0,0 +1,3 @@
+#pragma once
+
+// The host test build sets its defines (USE_HOST, USE_LIGHT_UDP, ...) on the compiler command line.
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+
+enum EntityCategory : uint8_t {
+  ENTITY_CATEGORY_NONE = 0,
+  ENTITY_CATEGORY_CONFIG = 1,
+  ENTITY_CATEGORY_DIAGNOSTIC = 2,
+};
+
+class EntityBase {
+ public:
+  const std::string &get_name() const { return this->name_; }
+  void set_name(const char *name) {
+    this->name_ = name;
+    this->object_id_ = str_snake_case(str_lower_case(this->name_));
+    this->object_id_hash_ = fnv1_hash(this->object_id_);
+  }
+  bool has_own_name() const { return !this->name_.empty(); }
+
+  std::string get_object_id() const { return this->object_id_; }
+  void set_object_id(const char *object_id) {
+    this->object_id_ = object_id;
+    this->object_id_hash_ = fnv1_hash(this->object_id_);
+  }
+  uint32_t get_object_id_hash() { return this->object_id_hash_; }
+
+  bool is_internal() const { return this->internal_; }
+  void set_internal(bool internal) { this->internal_ = internal; }
+  bool is_disabled_by_default() const { return this->disabled_by_default_; }
+  void set_disabled_by_default(bool disabled_by_default) { this->disabled_by_default_ = disabled_by_default; }
+  std::string get_icon() const { return this->icon_; }
+  void set_icon(const char *icon) { this->icon_ = icon; }
+  EntityCategory get_entity_category() const { return this->entity_category_; }
+  void set_entity_category(EntityCategory entity_category) { this->entity_category_ = entity_category; }
+
+ protected:
+  std::string name_;
+  std::string object_id_;
+  std::string icon_;
+  uint32_t object_id_hash_{0};
+  bool internal_{false};
+  bool disabled_by_default_{false};
+  EntityCategory entity_category_{ENTITY_CATEGORY_NONE};
+};
+
+}  // namespace esphome
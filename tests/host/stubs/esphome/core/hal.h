@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+
+// The host test build runs on a simulated clock that only moves when a test advances it, see host_clock.h.
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+uint32_t arch_get_cpu_cycle_count();
+void arch_feed_wdt();
+
+}  // namespace esphome
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "esphome/core/optional.h"
+
+#define ESPDEPRECATED(msg, when) __attribute__((deprecated(msg)))
+#define ALWAYS_INLINE __attribute__((always_inline))
+#define ESPHOME_ALWAYS_INLINE __attribute__((always_inline))
+#define HOT __attribute__((hot))
+#define PROGMEM
+
+namespace esphome {
+
+// The helpers of ESPHome's core/helpers.h that the light stack uses, with the same behaviour.
+
+using std::make_unique;
+
+template<typename T> constexpr const T &clamp(const T &v, const T &lo, const T &hi) {
+  return v < lo ? lo : (hi < v ? hi : v);
+}
+
+template<typename T, typename U> T remap(U value, U min, U max, T min_out, T max_out) {
+  return (value - min) * (max_out - min_out) / (max - min) + min_out;
+}
+
+float lerp(float completion, float start, float end);
+
+uint32_t random_uint32();
+float random_float();
+
+uint32_t fnv1_hash(const std::string &str);
+
+constexpr uint16_t encode_uint16(uint8_t msb, uint8_t lsb) { return (uint16_t(msb) << 8) | uint16_t(lsb); }
+constexpr uint32_t encode_uint32(uint8_t byte1, uint8_t byte2, uint8_t byte3, uint8_t byte4) {
+  return (uint32_t(byte1) << 24) | (uint32_t(byte2) << 16) | (uint32_t(byte3) << 8) | uint32_t(byte4);
+}
+
+bool str_equals_case_insensitive(const std::string &a, const std::string &b);
+std::string str_lower_case(const std::string &str);
+std::string str_snake_case(const std::string &str);
+std::string to_string(int value);
+
+enum ParseOnOffState {
+  PARSE_NONE = 0,
+  PARSE_ON,
+  PARSE_OFF,
+  PARSE_TOGGLE,
+};
+ParseOnOffState parse_on_off(const char *str, const char *on = nullptr, const char *off = nullptr);
+
+float gamma_correct(float value, float gamma);
+float gamma_uncorrect(float value, float gamma);
+
+inline uint8_t progmem_read_byte(const uint8_t *addr) { return *addr; }
+
+template<typename... X> class CallbackManager;
+
+template<typename... Ts> class CallbackManager<void(Ts...)> {
+ public:
+  void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+  void call(Ts... args) {
+    for (auto &cb : this->callbacks_)
+      cb(args...);
+  }
+  size_t size() const { return this->callbacks_.size(); }
+  void operator()(Ts... args) { this->call(args...); }
+
+ protected:
+  std::vector<std::function<void(Ts...)>> callbacks_;
+};
+
+}  // namespace esphome
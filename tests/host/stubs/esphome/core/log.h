@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdio>
+
+#include "esphome/core/defines.h"
+
+// Log lines of the host test build go to stderr, at the level of the ESPHOME_LOG_LEVEL define (default WARN).
+#define ESPHOME_LOG_LEVEL_NONE 0
+#define ESPHOME_LOG_LEVEL_ERROR 1
+#define ESPHOME_LOG_LEVEL_WARN 2
+#define ESPHOME_LOG_LEVEL_INFO 3
+#define ESPHOME_LOG_LEVEL_CONFIG 4
+#define ESPHOME_LOG_LEVEL_DEBUG 5
+#define ESPHOME_LOG_LEVEL_VERBOSE 6
+#define ESPHOME_LOG_LEVEL_VERY_VERBOSE 7
+
+#ifndef ESPHOME_LOG_LEVEL
+#define ESPHOME_LOG_LEVEL ESPHOME_LOG_LEVEL_WARN
+#endif
+
+namespace esphome {
+namespace host {
+/// Level a test turned the log down to at runtime, ESPHOME_LOG_LEVEL until it does (see host.h).
+int log_level();
+}  // namespace host
+}  // namespace esphome
+
+#define esph_log(level, letter, tag, format, ...) \
+  do { \
+    if ((level) <= ESPHOME_LOG_LEVEL && (level) <= esphome::host::log_level()) \
+      fprintf(stderr, "[" letter "][%s] " format "\n", tag, ##__VA_ARGS__); \
+  } while (0)
+
+#define ESP_LOGE(tag, ...) esph_log(ESPHOME_LOG_LEVEL_ERROR, "E", tag, __VA_ARGS__)
+#define ESP_LOGW(tag, ...) esph_log(ESPHOME_LOG_LEVEL_WARN, "W", tag, __VA_ARGS__)
+#define ESP_LOGI(tag, ...) esph_log(ESPHOME_LOG_LEVEL_INFO, "I", tag, __VA_ARGS__)
+#define ESP_LOGCONFIG(tag, ...) esph_log(ESPHOME_LOG_LEVEL_CONFIG, "C", tag, __VA_ARGS__)
+#define ESP_LOGD(tag, ...) esph_log(ESPHOME_LOG_LEVEL_DEBUG, "D", tag, __VA_ARGS__)
+#define ESP_LOGV(tag, ...) esph_log(ESPHOME_LOG_LEVEL_VERBOSE, "V", tag, __VA_ARGS__)
+#define ESP_LOGVV(tag, ...) esph_log(ESPHOME_LOG_LEVEL_VERY_VERBOSE, "VV", tag, __VA_ARGS__)
+
+#define YESNO(b) ((b) ? "YES" : "NO")
+#define ONOFF(b) ((b) ? "ON" : "OFF")
+#define TRUEFALSE(b) ((b) ? "TRUE" : "FALSE")
+
+namespace esphome {
+using LogString = char;
+}  // namespace esphome
+
+#define LOG_STR(s) (s)
+#define LOG_STR_ARG(s) (s)
+#define LOG_STR_LITERAL(s) (s)
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <utility>
+
+namespace esphome {
+
+// Minimal stand-in for ESPHome's optional<>, which predates std::optional in the code base.
+struct nullopt_t {
+  explicit constexpr nullopt_t(int) {}
+};
+constexpr nullopt_t nullopt{0};
+
+template<typename T> class optional {  // NOLINT
+ public:
+  using value_type = T;
+
+  optional() {}  // NOLINT
+  optional(nullopt_t) {}  // NOLINT
+  optional(const T &value) : has_value_(true), value_(value) {}  // NOLINT
+  template<typename U> optional(const optional<U> &other) : has_value_(other.has_value()) {  // NOLINT
+    if (other.has_value())
+      this->value_ = *other;
+  }
+
+  optional &operator=(nullopt_t) {
+    this->reset();
+    return *this;
+  }
+  template<typename U> optional &operator=(const optional<U> &other) {
+    if (other.has_value()) {
+      *this = *other;
+    } else {
+      this->reset();
+    }
+    return *this;
+  }
+  template<typename U> optional &operator=(const U &value) {
+    this->has_value_ = true;
+    this->value_ = value;
+    return *this;
+  }
+
+  bool has_value() const { return this->has_value_; }
+  explicit operator bool() const { return this->has_value_; }
+  void reset() {
+    this->has_value_ = false;
+    this->value_ = T();
+  }
+
+  T &value() { return this->value_; }
+  const T &value() const { return this->value_; }
+  template<typename U> T value_or(const U &v) const { return this->has_value_ ? this->value_ : static_cast<T>(v); }
+
+  T &operator*() { return this->value_; }
+  const T &operator*() const { return this->value_; }
+  T *operator->() { return &this->value_; }
+  const T *operator->() const { return &this->value_; }
+
+ private:
+  bool has_value_{false};
+  T value_{};
+};
+
+template<typename T> optional<T> make_optional(const T &value) { return optional<T>(value); }
+
+template<typename T, typename U> bool operator==(const optional<T> &x, const optional<U> &y) {
+  return bool(x) != bool(y) ? false : !bool(x) ? true : *x == *y;
+}
+template<typename T, typename U> bool operator!=(const optional<T> &x, const optional<U> &y) { return !(x == y); }
+template<typename T> bool operator==(const optional<T> &x, nullopt_t) { return !x; }
+template<typename T> bool operator!=(const optional<T> &x, nullopt_t) { return bool(x); }
+template<typename T, typename U> bool operator==(const optional<T> &x, const U &v) { return bool(x) && *x == v; }
+template<typename T, typename U> bool operator!=(const optional<T> &x, const U &v) { return !(x == v); }
+
+}  // namespace esphome
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace esphome {
+
+// Preferences of the host test build are kept in memory per key, so a restore test can save, rebuild a light and
+// load again.
+class ESPPreferenceObject {
+ public:
+  ESPPreferenceObject() = default;
+  explicit ESPPreferenceObject(std::vector<uint8_t> *data) : data_(data) {}
+
+  template<typename T> bool save(const T *src) {
+    if (this->data_ == nullptr)
+      return false;
+    const auto *bytes = reinterpret_cast<const uint8_t *>(src);
+    this->data_->assign(bytes, bytes + sizeof(T));
+    return true;
+  }
+
+  template<typename T> bool load(T *dest) {
+    if (this->data_ == nullptr || this->data_->size() != sizeof(T))
+      return false;
+    memcpy(dest, this->data_->data(), sizeof(T));
+    return true;
+  }
+
+ protected:
+  std::vector<uint8_t> *data_{nullptr};
+};
+
+class ESPPreferences {
+ public:
+  template<typename T> ESPPreferenceObject make_preference(uint32_t type, bool in_flash = false) {
+    return ESPPreferenceObject(&this->data_[type]);
+  }
+  template<typename T> ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash = false) {
+    return ESPPreferenceObject(&this->data_[type]);
+  }
+  bool sync() { return true; }
+  void clear() { this->data_.clear(); }
+
+ protected:
+  std::map<uint32_t, std::vector<uint8_t>> data_;
+};
+
+extern ESPPreferences *global_preferences;  // NOLINT
+
+}  // namespace esphome
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "IPAddress.h"
+
+namespace esphome {
+namespace host {
+
+// Controls for the simulated platform of the host test build.
+
+/// Simulated clock behind millis() and micros(), it only moves when a test advances it.
+void set_time_us(uint64_t time_us);
+void advance_us(uint32_t us);
+void advance_ms(uint32_t ms);
+
+/// Set the system clock (gettimeofday()) to the Unix time, as SNTP does. It then runs with the simulated clock, until
+/// then it counts from 1970 like an ESP8266 that was never synchronized.
+void set_system_clock(uint32_t unix_seconds);
+
+/// Number of operator new calls so far, to check a code path doesn't touch the heap.
+uint64_t allocations();
+
+/// Log only up to this level (one of the ESPHOME_LOG_LEVEL_ values) from now on, to keep a test that warns on purpose
+/// from flooding the output.
+void set_log_level(int level);
+
+/// Seed of the random_uint32() / random_float() stand-ins for the hardware RNG.
+void seed_random(uint32_t seed);
+
+/// WiFi station state. Disconnecting drops all multicast memberships, like lwIP does.
+void set_wifi_connected(bool connected);
+void set_local_ip(IPAddress ip);
+
+/// Queue a packet at every socket bound to the port (unicast), or that joined the group (multicast).
+void send_to_port(uint16_t port, const std::vector<uint8_t> &data);
+void send_to_group(IPAddress group, uint16_t port, const std::vector<uint8_t> &data);
+/// Queue a packet only at the sockets bound to the port while the local IP was this host's.
+void send_to_host(IPAddress host, uint16_t port, const std::vector<uint8_t> &data);
+/// Make binding to the port fail (or work again), like when another socket holds it.
+void block_port(uint16_t port, bool blocked);
+/// Number of sockets currently bound to the port, multicast or not.
+int bound_sockets(uint16_t port);
+
+struct SentPacket {
+  std::string host;
+  uint16_t port;
+  std::vector<uint8_t> data;
+};
+/// Everything sent through WiFiUDP since the last reset.
+std::vector<SentPacket> &sent_packets();
+
+/// Back to a connected station on 192.168.1.50 with nothing sent or queued, and the system clock not set by SNTP.
+void reset_network();
+
+}  // namespace host
+}  // namespace esphome
@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <set>
+#include <sys/time.h>
+
+#include "esphome/core/color.h"
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
+#include "esphome/components/wifi/wifi_component.h"
+#include "ESP8266WiFi.h"
+#include "WiFiUdp.h"
+#include "host.h"
+
+namespace esphome {
+
+// ---------- hal ----------
+
+static uint64_t time_us = 0;  // NOLINT
+
+uint32_t millis() { return uint32_t(time_us / 1000); }
+uint32_t micros() { return uint32_t(time_us); }
+void delay(uint32_t ms) { time_us += uint64_t(ms) * 1000; }
+void delayMicroseconds(uint32_t us) { time_us += us; }
+uint32_t arch_get_cpu_cycle_count() {
+  // nanoseconds of the real clock, so profiles and benchmarks measure actual host time
+  return uint32_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count());
+}
+void arch_feed_wdt() {}
+
+// Unix time in us at simulated time 0, the system clock isn't set until a test sets it
+static int64_t system_clock_base_us = 0;  // NOLINT
+
+// ---------- helpers ----------
+
+static uint32_t random_state = 0x12345678;  // NOLINT
+
+uint32_t random_uint32() {
+  // xorshift32 stands in for the hardware RNG, so test runs are repeatable
+  uint32_t x = random_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  random_state = x;
+  return x;
+}
+float random_float() { return float(random_uint32()) / float(UINT32_MAX); }
+
+float lerp(float completion, float start, float end) { return start + (end - start) * completion; }
+
+uint32_t fnv1_hash(const std::string &str) {
+  uint32_t hash = 2166136261UL;
+  for (char c : str) {
+    hash *= 16777619UL;
+    hash ^= c;
+  }
+  return hash;
+}
+
+bool str_equals_case_insensitive(const std::string &a, const std::string &b) {
+  return strcasecmp(a.c_str(), b.c_str()) == 0;
+}
+ParseOnOffState parse_on_off(const char *str, const char *on, const char *off) {
+  if (on == nullptr && strcasecmp(str, "on") == 0)
+    return PARSE_ON;
+  if (on != nullptr && strcasecmp(str, on) == 0)
+    return PARSE_ON;
+  if (off == nullptr && strcasecmp(str, "off") == 0)
+    return PARSE_OFF;
+  if (off != nullptr && strcasecmp(str, off) == 0)
+    return PARSE_OFF;
+  if (strcasecmp(str, "toggle") == 0)
+    return PARSE_TOGGLE;
+  return PARSE_NONE;
+}
+std::string str_lower_case(const std::string &str) {
+  std::string result(str);
+  std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+  return result;
+}
+std::string str_snake_case(const std::string &str) {
+  std::string result(str);
+  std::replace(result.begin(), result.end(), ' ', '_');
+  return result;
+}
+std::string to_string(int value) { return std::to_string(value); }
+
+float gamma_correct(float value, float gamma) {
+  if (value <= 0.0f)
+    return 0.0f;
+  if (gamma <= 0.0f)
+    return value;
+  return powf(value, gamma);
+}
+float gamma_uncorrect(float value, float gamma) {
+  if (value <= 0.0f)
+    return 0.0f;
+  if (gamma <= 0.0f)
+    return value;
+  return powf(value, 1 / gamma);
+}
+
+const Color Color::BLACK(0, 0, 0, 0);
+const Color Color::WHITE(255, 255, 255, 255);
+
+// ---------- component ----------
+
+namespace setup_priority {
+const float BUS = 1000.0f;
+const float IO = 900.0f;
+const float HARDWARE = 800.0f;
+const float DATA = 600.0f;
+const float PROCESSOR = 400.0f;
+const float WIFI = 250.0f;
+const float AFTER_WIFI = 200.0f;
+const float AFTER_CONNECTION = 100.0f;
+const float LATE = -100.0f;
+}  // namespace setup_priority
+
+float Component::get_setup_priority() const { return setup_priority::DATA; }
+
+// ---------- preferences ----------
+
+static ESPPreferences preferences;  // NOLINT
+ESPPreferences *global_preferences = &preferences;
+
+// ---------- network ----------
+
+static bool wifi_connected = true;                  // NOLINT
+static IPAddress local_ip(192, 168, 1, 50);         // NOLINT
+static std::set<WiFiUDP *> sockets;                 // NOLINT
+static std::set<uint16_t> blocked_ports;            // NOLINT
+static std::vector<host::SentPacket> sent;          // NOLINT
+
+namespace wifi {
+static WiFiComponent wifi_component;  // NOLINT
+WiFiComponent *global_wifi_component = &wifi_component;
+
+bool WiFiComponent::is_connected() { return wifi_connected; }
+network::IPAddresses WiFiComponent::get_ip_addresses() {
+  network::IPAddresses addresses;
+  addresses[0] = network::IPAddress(local_ip[0], local_ip[1], local_ip[2], local_ip[3]);
+  return addresses;
+}
+}  // namespace wifi
+
+namespace host {
+
+static uint64_t allocation_count = 0;  // NOLINT
+uint64_t allocations() { return allocation_count; }
+
+void set_time_us(uint64_t us) { time_us = us; }
+void advance_us(uint32_t us) { time_us += us; }
+void advance_ms(uint32_t ms) { time_us += uint64_t(ms) * 1000; }
+
+void set_system_clock(uint32_t unix_seconds) {
+  system_clock_base_us = int64_t(unix_seconds) * 1000000 - int64_t(time_us);
+}
+
+static int runtime_log_level = ESPHOME_LOG_LEVEL;  // NOLINT
+int log_level() { return runtime_log_level; }
+void set_log_level(int level) { runtime_log_level = level; }
+
+void seed_random(uint32_t seed) { random_state = seed != 0 ? seed : 1; }
+
+void set_wifi_connected(bool connected) {
+  wifi_connected = connected;
+  if (!connected) {
+    for (auto *socket : sockets) {
+      if (socket->multicast_)
+        socket->group_ = IPAddress();
+    }
+  }
+}
+void set_local_ip(IPAddress ip) { local_ip = ip; }
+
+void send_to_port(uint16_t port, const std::vector<uint8_t> &data) {
+  for (auto *socket : sockets) {
+    if (socket->port_ == port)
+      socket->rx_.push_back(data);
+  }
+}
+void send_to_group(IPAddress group, uint16_t port, const std::vector<uint8_t> &data) {
+  for (auto *socket : sockets) {
+    if (socket->port_ == port && socket->multicast_ && socket->group_ == group)
+      socket->rx_.push_back(data);
+  }
+}
+void block_port(uint16_t port, bool blocked) {
+  if (blocked) {
+    blocked_ports.insert(port);
+  } else {
+    blocked_ports.erase(port);
+  }
+}
+void send_to_host(IPAddress host, uint16_t port, const std::vector<uint8_t> &data) {
+  for (auto *socket : sockets) {
+    if (socket->port_ == port && socket->local_ip_ == host)
+      socket->rx_.push_back(data);
+  }
+}
+int bound_sockets(uint16_t port) {
+  return std::count_if(sockets.begin(), sockets.end(), [port](WiFiUDP *socket) { return socket->port_ == port; });
+}
+
+std::vector<SentPacket> &sent_packets() { return sent; }
+
+void reset_network() {
+  wifi_connected = true;
+  local_ip = IPAddress(192, 168, 1, 50);
+  blocked_ports.clear();
+  sent.clear();
+  system_clock_base_us = 0;
+  for (auto *socket : sockets)
+    socket->rx_.clear();
+}
+
+}  // namespace host
+}  // namespace esphome
+
+using namespace esphome;  // NOLINT
+
+// the system clock of the simulated platform, in place of the C library's
+extern "C" int gettimeofday(struct timeval *__restrict tv, void *__restrict tz) noexcept {
+  const int64_t now_us = system_clock_base_us + int64_t(time_us);
+  tv->tv_sec = time_t(now_us / 1000000);
+  tv->tv_usec = suseconds_t(now_us % 1000000);
+  return 0;
+}
+
+// every heap allocation of the test binaries, counted for host::allocations()
+void *operator new(size_t size) {
+  esphome::host::allocation_count++;
+  if (void *p = std::malloc(size != 0 ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+ESP8266WiFiClass WiFi;  // NOLINT
+
+IPAddress ESP8266WiFiClass::localIP() { return wifi_connected ? local_ip : IPAddress(); }
+bool ESP8266WiFiClass::isConnected() { return wifi_connected; }
+
+WiFiUDP::WiFiUDP() { sockets.insert(this); }
+WiFiUDP::~WiFiUDP() { sockets.erase(this); }
+
+uint8_t WiFiUDP::begin(uint16_t port) {
+  if (blocked_ports.count(port))
+    return 0;
+  this->port_ = port;
+  this->local_ip_ = local_ip;
+  this->multicast_ = false;
+  return 1;
+}
+uint8_t WiFiUDP::beginMulticast(IPAddress interface_addr, IPAddress multicast, uint16_t port) {
+  // joining a group needs the address of a connected interface
+  if (!wifi_connected || !interface_addr.isSet() || blocked_ports.count(port))
+    return 0;
+  this->port_ = port;
+  this->local_ip_ = local_ip;
+  this->multicast_ = true;
+  this->group_ = multicast;
+  return 1;
+}
+void WiFiUDP::stop() {
+  this->port_ = 0;
+  this->multicast_ = false;
+  this->rx_.clear();
+}
+
+int WiFiUDP::parsePacket() {
+  if (this->rx_.empty())
+    return 0;
+  this->current_ = std::move(this->rx_.front());
+  this->rx_.pop_front();
+  return this->current_.size();
+}
+int WiFiUDP::read(uint8_t *buffer, size_t len) {
+  const size_t n = std::min(len, this->current_.size());
+  memcpy(buffer, this->current_.data(), n);
+  this->current_.erase(this->current_.begin(), this->current_.begin() + n);
+  return n;
+}
+
+int WiFiUDP::beginPacket(const char *host, uint16_t port) {
+  if (!wifi_connected)
+    return 0;
+  this->tx_host_ = host;
+  this->tx_port_ = port;
+  this->tx_.clear();
+  this->tx_open_ = true;
+  return 1;
+}
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port) { return this->beginPacket(ip.toString().c_str(), port); }
+size_t WiFiUDP::write(uint8_t byte) { return this->write(&byte, 1); }
+size_t WiFiUDP::write(const uint8_t *buffer, size_t size) {
+  if (!this->tx_open_)
+    return 0;
+  this->tx_.insert(this->tx_.end(), buffer, buffer + size);
+  return size;
+}
+int WiFiUDP::endPacket() {
+  if (!this->tx_open_)
+    return 0;
+  this->tx_open_ = false;
+  sent.push_back({this->tx_host_, this->tx_port_, this->tx_});
+  return 1;
+}
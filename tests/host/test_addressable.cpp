@@ -0,0 +1,147 @@
+#include "addressable_strip.h"
+#include "esphome/components/light/addressable_light_effect.h"
+#include "runner.h"
+
+using namespace esphome;
+using namespace esphome::light;
+using namespace esphome::testing;
+
+TEST_CASE(addressable_blend_matches_color_operators) {
+  // every alpha, pixel and target value, the same in all four channels
+  bool identical = true;
+  for (uint32_t alpha8 = 1; alpha8 < 256 && identical; alpha8++) {
+    for (uint32_t current = 0; current < 256 && identical; current++) {
+      for (uint32_t target = 0; target < 256; target++) {
+        const Color led(current, current, current, current);
+        const Color add = Color(target, target, target, target) * uint8_t(alpha8);
+        const Color expected = add + led * uint8_t(255 - alpha8);
+        if (AddressableLightTransformer::blend(led, add, alpha8).raw_32 != expected.raw_32) {
+          EXPECT_EQ(AddressableLightTransformer::blend(led, add, alpha8).raw_32, expected.raw_32);
+          identical = false;
+          break;
+        }
+      }
+    }
+  }
+
+  // and different values in each channel, where a carry between the lanes would show
+  uint32_t random = 0xB1E4D;
+  for (uint32_t i = 0; i < 1000000 && identical; i++) {
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+    Color led, target;
+    led.raw_32 = random;
+    target.raw_32 = random * 2654435761u;
+    const uint8_t alpha8 = 1 + i % 255;
+    const Color add = target * alpha8;
+    const Color expected = add + led * uint8_t(255 - alpha8);
+    if (AddressableLightTransformer::blend(led, add, alpha8).raw_32 != expected.raw_32) {
+      EXPECT_EQ(AddressableLightTransformer::blend(led, add, alpha8).raw_32, expected.raw_32);
+      identical = false;
+    }
+  }
+}
+
+TEST_CASE(addressable_transition_fades_every_pixel_to_the_target) {
+  AddressableStrip strip(60);
+  strip.setup();
+  strip.light.turn_on().set_rgbw(0.0f, 0.0f, 1.0f, 0.0f).set_brightness(1.0f).perform();
+  strip.run_for(32);
+  // an effect left the pixels in all sorts of colors
+  for (int32_t i = 0; i < 60; i++)
+    strip.output[i] = Color(i * 4, 255 - i * 4, 0, 0);
+
+  strip.light.turn_on().set_rgbw(1.0f, 0.0f, 0.0f, 0.0f).set_transition_length(1000).perform();
+  strip.run_for(496);
+  // half way every pixel has moved from where it was, but isn't there yet
+  for (int32_t i = 0; i < 60; i++) {
+    const Color halfway = strip.output[i].get();
+    EXPECT_TRUE(halfway.red > i * 4 && halfway.red < 255);
+  }
+  strip.run_for(600);
+
+  const Color target = strip.output.correction().color_correct(Color(255, 0, 0, 0));
+  for (int32_t i = 0; i < 60; i++)
+    EXPECT_EQ(strip.output[i].get_raw().raw_32, target.raw_32);
+}
+
+TEST_CASE(addressable_rainbow_matches_a_hue_per_led) {
+  // the ramp through the shared table against converting every LED's hue and setting it on its own, as the effect
+  // used to
+  for (uint16_t width : {1, 7, 50, 300, 1000}) {
+    AddressableStrip strip(300), reference(300);
+    strip.setup();
+    reference.setup();
+    for (AddressableStrip *s : {&strip, &reference}) {
+      s->light.turn_on().set_rgbw(1.0f, 1.0f, 1.0f, 0.5f).set_brightness(0.7f).perform();
+      s->loop();
+    }
+    AddressableRainbowLightEffect rainbow("Rainbow");
+    rainbow.set_width(width);
+    rainbow.set_speed(37);
+    host::advance_ms(width * 13);
+    rainbow.apply(strip.output, Color::WHITE);
+
+    uint16_t hue = (millis() * 37) % 0xFFFF;
+    for (auto led : reference.output) {
+      const Color rgb = ESPHSVColor(hue >> 8, 240, 255).to_rgb();
+      led.set_rgb(rgb.r, rgb.g, rgb.b);
+      hue += 0xFFFF / width;
+    }
+    for (int32_t i = 0; i < 300; i++)
+      EXPECT_EQ(strip.output[i].get_raw().raw_32, reference.output[i].get_raw().raw_32);
+  }
+}
+
+TEST_CASE(addressable_power_supply_follows_lit_pixels) {
+  AddressableStrip strip(100);
+  strip.setup();
+  EXPECT_TRUE(!strip.power.is_enabled());
+
+  strip.light.turn_on().set_rgbw(0.0f, 1.0f, 0.0f, 0.0f).set_brightness(0.5f).perform();
+  strip.loop();
+  EXPECT_TRUE(strip.power.is_enabled());
+
+  // an effect clears the strip, lights a few pixels, copies them along and clears them again
+  strip.output.all() = Color::BLACK;
+  strip.show();
+  EXPECT_TRUE(!strip.power.is_enabled());
+  for (int32_t i = 90; i < 100; i++)
+    strip.output[i] = Color(0, 0, 255, 0);
+  strip.show();
+  EXPECT_TRUE(strip.power.is_enabled());
+  strip.output.range(0, 10) = strip.output.range(90, 100);
+  strip.output.range(90, 100) = Color::BLACK;
+  strip.show();
+  EXPECT_TRUE(strip.power.is_enabled());
+  for (auto led : strip.output.range(0, 10))
+    led.set_blue(0);
+  strip.show();
+  EXPECT_TRUE(!strip.power.is_enabled());
+
+  strip.light.turn_on().set_brightness(1.0f).perform();
+  strip.loop();
+  EXPECT_TRUE(strip.power.is_enabled());
+  strip.light.turn_off().perform();
+  strip.loop();
+  EXPECT_TRUE(!strip.power.is_enabled());
+}
+
+TEST_CASE(addressable_power_supply_sees_pixels_written_around_the_views) {
+  AddressableStrip strip(100);
+  strip.setup();
+
+  // a driver writing its buffer directly: nothing was counted, so the dark strip is checked pixel by pixel
+  strip.output.pixels()[4 * 57 + 3] = 20;
+  strip.show();
+  EXPECT_TRUE(strip.power.is_enabled());
+  // clearing it the same way isn't seen, the power supply stays on rather than going off under a lit pixel
+  strip.output.pixels()[4 * 57 + 3] = 0;
+  strip.show();
+  EXPECT_TRUE(strip.power.is_enabled());
+  // until the whole strip is set again, like when the light is turned off
+  strip.light.turn_off().perform();
+  strip.loop();
+  EXPECT_TRUE(!strip.power.is_enabled());
+}
@@ -0,0 +1,62 @@
+#include "esphome/components/light/esp_color_correction.h"
+#include "runner.h"
+
+using namespace esphome;
+using namespace esphome::light;
+
+namespace {
+
+/// color_uncorrect_*() as it was before the divisions were replaced, for one channel.
+uint8_t reference_uncorrect(uint8_t reverse_gamma, uint8_t max_brightness, uint8_t local_brightness) {
+  if (max_brightness == 0 || local_brightness == 0)
+    return 0;
+  uint16_t uncorrected = reverse_gamma * 255UL;
+  uint8_t res = ((uncorrected / max_brightness) * 255UL) / local_brightness;
+  return res;
+}
+
+}  // namespace
+
+TEST_CASE(color_uncorrect_matches_divisions_exhaustively) {
+  // gamma 0 makes the reverse table the identity, so every possible table value is looked up once
+  ESPColorCorrection correction;
+  correction.calculate_gamma_table(0.0f);
+  uint32_t mismatches = 0;
+  for (uint16_t max = 0; max < 256; max++) {
+    correction.set_max_brightness(Color(max, max, 255 - max, max));
+    for (uint16_t local = 0; local < 256; local++) {
+      correction.set_local_brightness(local);
+      for (uint16_t value = 0; value < 256; value++) {
+        const Color c = correction.color_uncorrect(Color(value, value, value, value));
+        mismatches += c.red != reference_uncorrect(value, max, local);
+        mismatches += c.green != reference_uncorrect(value, max, local);
+        mismatches += c.blue != reference_uncorrect(value, 255 - max, local);
+        mismatches += c.white != reference_uncorrect(value, max, local);
+      }
+    }
+  }
+  EXPECT_EQ(mismatches, 0u);
+}
+
+TEST_CASE(color_correct_matches_each_channel_exhaustively) {
+  // with the same max brightness everywhere color_correct() scales all channels at once, otherwise one by one
+  ESPColorCorrection correction;
+  correction.calculate_gamma_table(2.8f);
+  uint32_t mismatches = 0;
+  for (uint16_t max = 0; max < 256; max++) {
+    for (const Color &max_brightness : {Color(max, max, max, max), Color(max, 255 - max, max, 128)}) {
+      correction.set_max_brightness(max_brightness);
+      for (uint16_t local = 0; local < 256; local++) {
+        correction.set_local_brightness(local);
+        for (uint16_t value = 0; value < 256; value++) {
+          const Color c = correction.color_correct(Color(value, 255 - value, value / 2, value ^ 0x5A));
+          mismatches += c.red != correction.color_correct_red(value);
+          mismatches += c.green != correction.color_correct_green(255 - value);
+          mismatches += c.blue != correction.color_correct_blue(value / 2);
+          mismatches += c.white != correction.color_correct_white(value ^ 0x5A);
+        }
+      }
+    }
+  }
+  EXPECT_EQ(mismatches, 0u);
+}
@@ -0,0 +1,490 @@
+#include "kauf_bulb.h"
+#include "runner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::testing;
+
+namespace {
+
+/// 8 bit RGB DDP packet with the given sequence number (0-15).
+std::vector<uint8_t> ddp_rgb(uint8_t seq, uint8_t r, uint8_t g, uint8_t b) {
+  return {0x41, seq, 0x0B, 0x01, 0, 0, 0, 0, 0, 3, r, g, b};
+}
+
+void feed(KaufBulb &bulb, const std::vector<uint8_t> &seqs) {
+  for (uint8_t seq : seqs) {
+    const auto packet = ddp_rgb(seq, 0x20, 0x80, 0xF0);
+    bulb.light.parse_frame_(packet.data(), packet.size());
+    host::advance_ms(20);
+  }
+}
+
+}  // namespace
+
+TEST_CASE(ddp_seq_in_order_has_no_gaps) {
+  KaufBulb bulb("DDP", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  // two full wraps of 1-15
+  std::vector<uint8_t> seqs;
+  for (int i = 0; i < 30; i++)
+    seqs.push_back(i % 15 + 1);
+  feed(bulb, seqs);
+  EXPECT_EQ(bulb.light.get_ddp_packets(), 30u);
+  EXPECT_EQ(bulb.light.get_ddp_seq_gaps(), 0u);
+}
+
+TEST_CASE(ddp_seq_counts_lost_packets) {
+  KaufBulb bulb("DDP", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  // 3 missing, then 14 and 15 missing across the wrap, then a jump of 7 (6 missing)
+  feed(bulb, {1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 1, 2, 9});
+  EXPECT_EQ(bulb.light.get_ddp_seq_gaps(), 1u + 2u + 6u);
+}
+
+TEST_CASE(ddp_seq_ignores_duplicates_and_reordering) {
+  KaufBulb bulb("DDP", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  // a retransmit of 5, then 7 overtaking 6
+  feed(bulb, {3, 4, 5, 5, 7, 6, 8, 9});
+  EXPECT_EQ(bulb.light.get_ddp_seq_gaps(), 1u);
+  EXPECT_EQ(bulb.light.get_ddp_packets(), 8u);
+}
+
+TEST_CASE(ddp_seq_counts_bursts_of_lost_packets) {
+  KaufBulb bulb("DDP", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  // 4-12 missing, which looks like 13 arrived late until 14 follows it, then 4-10 missing
+  feed(bulb, {1, 2, 3, 13, 14, 15, 1, 2, 3, 11, 12, 13, 14});
+  EXPECT_EQ(bulb.light.get_ddp_seq_gaps(), 9u + 7u);
+
+  // and counting goes on from there
+  feed(bulb, {15, 2, 3});
+  EXPECT_EQ(bulb.light.get_ddp_seq_gaps(), 9u + 7u + 1u);
+}
+
+TEST_CASE(ddp_seq_zero_disables_counting) {
+  KaufBulb bulb("DDP", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  feed(bulb, {0, 0, 0, 5, 0, 9});
+  EXPECT_EQ(bulb.light.get_ddp_seq_gaps(), 0u);
+}
+
+TEST_CASE(ddp_jitter_percentiles_follow_the_recent_stream) {
+  KaufBulb bulb("DDP", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  auto stream = [&bulb](uint32_t duration_ms, uint32_t jitter_ms) {
+    const auto packet = ddp_rgb(0, 0x20, 0x80, 0xF0);
+    for (uint32_t t = 0; t < duration_ms; t += 20) {
+      host::advance_ms(t % 40 == 0 ? 20 - jitter_ms : 20 + jitter_ms);
+      bulb.light.parse_frame_(packet.data(), packet.size());
+    }
+  };
+
+  // intervals alternating between 12 and 28 ms, so each one is 16 ms off the last
+  stream(5000, 8);
+  EXPECT_EQ(bulb.light.get_ddp_jitter_percentile(0.5f), 16.384f);
+  // then a steady 20 ms, after five seconds only a few percent of the histogram are from before
+  stream(5000, 0);
+  EXPECT_EQ(bulb.light.get_ddp_jitter_percentile(0.9f), 0.002f);
+  EXPECT_EQ(bulb.light.get_ddp_packets(), 500u);
+
+  // a stopped stream reads as 0, and one that starts again doesn't count the pause
+  host::advance_ms(3000);
+  EXPECT_EQ(bulb.light.get_ddp_jitter_percentile(0.5f), 0.0f);
+  stream(1000, 0);
+  EXPECT_EQ(bulb.light.get_ddp_jitter_percentile(1.0f), 0.002f);
+}
+
+TEST_CASE(ddp_latency_runs_from_receive_to_write) {
+  KaufBulb bulb("DDP", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  bulb.loop();  // binds the DDP port
+
+  host::send_to_port(4048, ddp_rgb(1, 0x20, 0x80, 0xF0));
+  bulb.loop();
+  EXPECT_EQ(bulb.light.get_ddp_frames(), 1u);
+  EXPECT_NEAR(bulb.light.get_ddp_max_latency(), 0.0f, 0.001f);
+}
+
+namespace {
+
+/// 8 bit RGB DDP packet for this bulb and the next one, both pixels the same color.
+std::vector<uint8_t> ddp_rgb_pair(uint8_t seq, uint8_t r, uint8_t g, uint8_t b) {
+  return {0x41, seq, 0x0B, 0x01, 0, 0, 0, 0, 0, 6, r, g, b, r, g, b};
+}
+
+}  // namespace
+
+TEST_CASE(ddp_forwarding_reads_every_queued_packet) {
+  host::reset_network();
+  KaufBulb bulb("DDP", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  bulb.loop();
+
+  // one pixel to forward leaves no second packet, the next frame still has to be read in the same loop
+  host::send_to_port(4048, ddp_rgb_pair(1, 255, 0, 0));
+  host::send_to_port(4048, ddp_rgb_pair(2, 0, 255, 0));
+  bulb.loop();
+  EXPECT_EQ(bulb.light.get_ddp_frames(), 2u);
+  EXPECT_NEAR(bulb.green.get_level(), 1.0f, 0.002f);
+  EXPECT_EQ(host::sent_packets().size(), 2u);
+  EXPECT_EQ(host::sent_packets()[1].host, std::string("192.168.1.51"));
+  host::reset_network();
+}
+
+TEST_CASE(ddp_forwarding_stops_at_254_but_keeps_reading) {
+  host::reset_network();
+  host::set_local_ip(IPAddress(192, 168, 1, 254));
+  KaufBulb bulb("DDP", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  bulb.loop();
+
+  host::send_to_port(4048, ddp_rgb_pair(1, 255, 0, 0));
+  host::send_to_port(4048, ddp_rgb_pair(2, 0, 255, 0));
+  bulb.loop();
+  EXPECT_EQ(bulb.light.get_ddp_frames(), 2u);
+  EXPECT_NEAR(bulb.green.get_level(), 1.0f, 0.002f);
+  EXPECT_EQ(host::sent_packets().size(), 0u);
+  host::reset_network();
+}
+
+TEST_CASE(ddp_latency_includes_the_jitter_buffer) {
+  KaufBulb bulb("DDP", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  bulb.light.set_ddp_jitter_buffer(50);
+  bulb.loop();
+
+  // a steady 50 fps stream, the loop running every millisecond
+  for (uint8_t i = 0; i < 100; i++) {
+    host::send_to_port(4048, ddp_rgb(i % 15 + 1, i, 0x80, 0xF0));
+    bulb.run_for(20, 1);
+  }
+  bulb.run_for(100, 1);
+
+  // every frame is written once playout reaches it, the buffer delay after it was received
+  EXPECT_EQ(bulb.light.get_ddp_frames(), 100u);
+  EXPECT_NEAR(bulb.light.get_ddp_latency(), 50.0f, 2.0f);
+  EXPECT_NEAR(bulb.light.get_ddp_max_latency(), 50.0f, 2.0f);
+}
+
+namespace {
+
+/// 8 bit RGB DDP packet with a timecode, the middle 32 bits of an NTP timestamp of the sender.
+std::vector<uint8_t> ddp_rgb_timecode(uint8_t seq, uint32_t timecode, uint8_t r, uint8_t g, uint8_t b) {
+  return {0x51, seq, 0x0B, 0x01, 0, 0, 0, 0, 0, 3, uint8_t(timecode >> 24), uint8_t(timecode >> 16),
+          uint8_t(timecode >> 8), uint8_t(timecode), r, g, b};
+}
+
+/// Sender clock in DDP timecode units (1/65536 s), unrelated to the bulbs' millis().
+uint32_t sender_timecode(uint32_t send_ms) { return 0x12345678u + uint32_t(uint64_t(send_ms) * 65536u / 1000u); }
+
+/// Deterministic network delay of 0-15 ms.
+struct Network {
+  uint32_t state;
+  uint32_t delay_ms() {
+    this->state ^= this->state << 13;
+    this->state ^= this->state >> 17;
+    this->state ^= this->state << 5;
+    return this->state % 16;
+  }
+};
+
+const uint32_t FRAME_MS = 20;
+/// The outputs round levels up to the next 0.001, in frames of the ramp.
+const float OUTPUT_RESOLUTION = 0.255f;
+const uint32_t FRAMES = 200;
+
+/** Replay a 50 fps ramp (red = frame number) to a bulb, the loop running every millisecond.
+ *
+ * Each frame gets its own random network delay, in order. Returns the red output in frames (red * 255) for each
+ * millisecond.
+ */
+std::vector<float> replay_ramp(uint32_t jitter_buffer_ms) {
+  KaufBulb bulb("Ramp", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  bulb.light.set_ddp_jitter_buffer(jitter_buffer_ms);
+  Network network{0xDDB0};
+  std::vector<uint32_t> arrival_ms;
+  for (uint32_t i = 0; i < FRAMES; i++) {
+    // a later frame can't overtake an earlier one on the same path
+    arrival_ms.push_back(std::max(1000 + i * FRAME_MS + network.delay_ms(), i > 0 ? arrival_ms.back() : 0));
+  }
+
+  std::vector<float> red;
+  uint32_t next = 0;
+  host::set_time_us(1000000);
+  for (uint32_t now = 1000; now < 1000 + FRAMES * FRAME_MS + 200; now++) {
+    while (next < FRAMES && arrival_ms[next] <= now) {
+      const auto packet = ddp_rgb(next % 15 + 1, next, 0, 0);
+      bulb.light.parse_frame_(packet.data(), packet.size());
+      next++;
+    }
+    bulb.light.loop();
+    red.push_back(bulb.red.get_level() * 255.0f);
+    host::advance_ms(1);
+  }
+  return red;
+}
+
+}  // namespace
+
+TEST_CASE(ddp_jitter_buffer_smooths_a_jittery_stream) {
+  // without the buffer every frame is a step of one or more, and late frames bunch up
+  const auto direct = replay_ramp(0);
+  const auto buffered = replay_ramp(50);
+
+  float direct_step = 0.0f, buffered_step = 0.0f;
+  bool buffered_monotonic = true;
+  // from the second second of the stream until its last frame was played
+  for (size_t t = 1000; t < FRAMES * FRAME_MS; t++) {
+    direct_step = std::max(direct_step, direct[t] - direct[t - 1]);
+    buffered_step = std::max(buffered_step, buffered[t] - buffered[t - 1]);
+    buffered_monotonic = buffered_monotonic && buffered[t] >= buffered[t - 1] - 0.001f;
+  }
+  EXPECT_TRUE(direct_step >= 1.0f);
+  // interpolated at 1/20 of a frame per millisecond, seen through the 0.001 resolution of the outputs (0.255 frames)
+  EXPECT_TRUE(buffered_step < 0.26f);
+  EXPECT_TRUE(buffered_monotonic);
+  EXPECT_NEAR(buffered.back(), FRAMES - 1, OUTPUT_RESOLUTION);
+}
+
+TEST_CASE(ddp_jitter_buffer_delays_by_its_length) {
+  const auto buffered = replay_ramp(50);
+  // frame i is sent at i * 20 ms, so the output is about (t - delay) / 20 after the stream started
+  float total = 0.0f;
+  uint32_t samples = 0;
+  for (size_t t = 1000; t < FRAMES * FRAME_MS - 100; t++) {
+    total += float(t) - buffered[t] * FRAME_MS;
+    samples++;
+  }
+  // the buffer plus some of the 0-15 ms network delay, less up to one output step (5 ms) of rounding up
+  const float delay = total / samples;
+  EXPECT_TRUE(delay > 50.0f - 5.0f && delay < 50.0f + 15.0f);
+}
+
+namespace {
+
+const uint8_t CHAIN_BULBS = 50;
+/// Unix time the simulated SNTP sets the system clock to.
+const uint32_t CHAIN_UNIX_SECONDS = 1760000000;
+
+IPAddress chain_ip(uint8_t k) { return IPAddress(192, 168, 1, 100 + k); }
+
+/// DDP timecode of the simulated clock, as NTP time once the system clock was set at 1 s.
+uint32_t ntp_timecode(uint64_t time_us) {
+  const uint64_t unix_us = uint64_t(CHAIN_UNIX_SECONDS) * 1000000u + time_us - 1000000u;
+  const uint32_t seconds = uint32_t(unix_us / 1000000u + 2208988800u);
+  return (seconds << 16) | uint32_t(((unix_us % 1000000u) << 16) / 1000000u);
+}
+
+/** Stream a 50 fps ramp (red = frame number, the same for every pixel) to the first of 50 bulbs on .100-.149.
+ *
+ * Every bulb shows its pixel and forwards the rest of the frame the way wled_apply() does, each hop of the chain
+ * taking a random 1-12 ms. The loops run every millisecond. Returns the red output of every bulb in frames
+ * (red * 255) for each millisecond from 1 s on, and the deepest hop count in depth.
+ */
+std::vector<std::vector<float>> stream_through_chain(bool ntp_clock, uint8_t *depth) {
+  host::reset_network();
+  host::set_time_us(0);
+  std::vector<std::unique_ptr<KaufBulb>> chain;
+  for (uint8_t k = 0; k < CHAIN_BULBS; k++) {
+    host::set_local_ip(chain_ip(k));
+    chain.push_back(make_unique<KaufBulb>("Chain", 0));
+    chain[k]->setup();
+    chain[k]->light.set_use_wled(true);
+    chain[k]->light.set_ddp_jitter_buffer(100);
+    chain[k]->light.set_ddp_ntp_clock(ntp_clock);
+    chain[k]->loop();  // binds the DDP port on this bulb's address
+  }
+  host::sent_packets().clear();
+  host::advance_ms(1000);
+  host::set_system_clock(CHAIN_UNIX_SECONDS);
+
+  struct InFlight {
+    uint32_t delivery_ms;
+    uint8_t bulb;
+    std::vector<uint8_t> data;
+  };
+  std::vector<InFlight> in_flight;
+  std::vector<uint32_t> last_delivery(CHAIN_BULBS, 0);
+  std::vector<uint8_t> hops(CHAIN_BULBS, 0);
+  Network network{0xC4A1};
+  std::vector<std::vector<float>> red(CHAIN_BULBS);
+  for (uint32_t now = 1000; now < 1000 + FRAMES * FRAME_MS + 300; now++) {
+    if (now % FRAME_MS == 0 && now < 1000 + FRAMES * FRAME_MS) {
+      const uint32_t frame = (now - 1000) / FRAME_MS;
+      const uint32_t timecode = ntp_timecode(uint64_t(now) * 1000u);
+      std::vector<uint8_t> packet = {0x51, uint8_t(frame % 15 + 1), 0x0B, 0x01, 0, 0, 0, 0, 0, CHAIN_BULBS * 3,
+                                     uint8_t(timecode >> 24), uint8_t(timecode >> 16), uint8_t(timecode >> 8),
+                                     uint8_t(timecode)};
+      for (uint8_t k = 0; k < CHAIN_BULBS; k++)
+        packet.insert(packet.end(), {uint8_t(frame), 0, 0});
+      host::send_to_host(chain_ip(0), 4048, packet);
+    }
+    for (auto it = in_flight.begin(); it != in_flight.end();) {
+      if (it->delivery_ms <= now) {
+        host::send_to_host(chain_ip(it->bulb), 4048, it->data);
+        it = in_flight.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    for (uint8_t k = 0; k < CHAIN_BULBS; k++) {
+      host::set_local_ip(chain_ip(k));
+      chain[k]->loop();
+      red[k].push_back(chain[k]->red.get_level() * 255.0f);
+      for (const auto &packet : host::sent_packets()) {
+        unsigned last_octet = 0;
+        sscanf(packet.host.c_str(), "192.168.1.%u", &last_octet);
+        const uint8_t to = last_octet - 100;
+        // one parent per bulb, so its packets arrive in order
+        last_delivery[to] = std::max(last_delivery[to], now + 1 + network.delay_ms() % 12);
+        hops[to] = hops[k] + 1;
+        in_flight.push_back({last_delivery[to], to, packet.data});
+      }
+      host::sent_packets().clear();
+    }
+    host::advance_ms(1);
+  }
+  *depth = *std::max_element(hops.begin(), hops.end());
+  host::reset_network();
+  return red;
+}
+
+/// Mean skew of every bulb behind the first one in milliseconds, from the difference of their ramps, and the largest
+/// difference at any millisecond.
+std::vector<float> chain_skew(const std::vector<std::vector<float>> &red, float *worst) {
+  std::vector<float> skew;
+  *worst = 0.0f;
+  for (uint8_t k = 0; k < CHAIN_BULBS; k++) {
+    float total = 0.0f;
+    uint32_t samples = 0;
+    // from the second second of the stream until its last frame was played
+    for (size_t t = 1000; t < FRAMES * FRAME_MS; t++) {
+      const float s = (red[0][t] - red[k][t]) * FRAME_MS;
+      total += s;
+      samples++;
+      *worst = std::max(*worst, std::fabs(s));
+    }
+    skew.push_back(total / samples);
+  }
+  return skew;
+}
+
+}  // namespace
+
+TEST_CASE(ddp_ntp_timecode_shows_the_frame_together_down_a_chain) {
+  uint8_t depth = 0;
+  float worst = 0.0f;
+  const auto skew = chain_skew(stream_through_chain(true, &depth), &worst);
+  float mean = 0.0f, largest = 0.0f;
+  for (float s : skew) {
+    mean += s / CHAIN_BULBS;
+    largest = std::max(largest, std::fabs(s));
+  }
+  printf("    %u bulbs, %u hops deep: mean skew %.2f ms, largest bulb mean %.2f ms, worst %.2f ms\n", CHAIN_BULBS, depth,
+         mean, largest, worst);
+
+  // Every bulb plays the frame at the sender's timecode plus the buffer, whatever the hops in front of it took. What's
+  // left is scheduling to whole milliseconds and the outputs rounding up by up to a step (0.255 frames, 5.1 ms).
+  EXPECT_TRUE(depth >= 5);
+  EXPECT_TRUE(largest < 1.0f);
+  EXPECT_TRUE(worst <= FRAME_MS * OUTPUT_RESOLUTION + 0.1f);
+}
+
+TEST_CASE(ddp_estimated_clock_skews_with_chain_depth) {
+  // without a synchronized clock every bulb anchors the timecodes to the shortest delay of its own path, which
+  // includes the hops before it
+  uint8_t depth = 0;
+  float worst = 0.0f;
+  const auto skew = chain_skew(stream_through_chain(false, &depth), &worst);
+  const float largest = *std::max_element(skew.begin(), skew.end());
+  printf("    %u bulbs, %u hops deep without NTP: largest bulb mean skew %.2f ms, worst %.2f ms\n", CHAIN_BULBS, depth,
+         largest, worst);
+  EXPECT_TRUE(largest > 1.0f * (depth - 1));
+}
+
+TEST_CASE(ddp_ntp_timecode_waits_without_jitter_buffer) {
+  host::reset_network();
+  host::set_time_us(1000000);
+  host::set_system_clock(CHAIN_UNIX_SECONDS);
+  KaufBulb bulb("DDP", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  bulb.light.set_ddp_ntp_clock(true);
+
+  // due in 100 ms: held until then, not applied as it arrives
+  const auto later = ddp_rgb_timecode(1, ntp_timecode(1100000), 255, 0, 0);
+  EXPECT_TRUE(bulb.light.parse_frame_(later.data(), later.size()));
+  bulb.run_for(90, 1);
+  EXPECT_EQ(bulb.red.get_level(), 0.0f);
+  bulb.run_for(12, 1);
+  EXPECT_NEAR(bulb.red.get_level(), 1.0f, 0.002f);
+  EXPECT_EQ(bulb.light.get_ddp_frames(), 1u);
+
+  // already due: applied at once
+  const auto late = ddp_rgb_timecode(2, ntp_timecode(1000000), 0, 255, 0);
+  EXPECT_TRUE(bulb.light.parse_frame_(late.data(), late.size()));
+  bulb.loop();
+  EXPECT_NEAR(bulb.green.get_level(), 1.0f, 0.002f);
+  host::reset_network();
+}
+
+TEST_CASE(ddp_timecode_without_jitter_buffer_applies_at_once) {
+  KaufBulb bulb("DDP", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+
+  // a sender clock the bulb knows nothing about yet: the first frame anchors the estimate and is due on arrival
+  const auto packet = ddp_rgb_timecode(1, sender_timecode(5000), 255, 0, 0);
+  EXPECT_TRUE(bulb.light.parse_frame_(packet.data(), packet.size()));
+  bulb.loop();
+  EXPECT_NEAR(bulb.red.get_level(), 1.0f, 0.002f);
+  EXPECT_EQ(bulb.light.get_ddp_frames(), 1u);
+}
+
+TEST_CASE(ddp_white_pixels_skip_calibration) {
+  KaufBulb bulb("DDP", 0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+
+  // an RGB pixel is blended like any color, blue scaled down by max_blue (0.6)
+  const std::vector<uint8_t> rgb = {0x41, 1, 0x0B, 0x01, 0, 0, 0, 0, 0, 3, 0, 0, 255};
+  EXPECT_TRUE(bulb.light.parse_frame_(rgb.data(), rgb.size()));
+  bulb.loop();
+  EXPECT_NEAR(bulb.blue.get_level(), 0.6f, 0.002f);
+
+  // RGB + cold white + warm white goes to the outputs as received, without max_blue or max_white
+  const std::vector<uint8_t> rgbww = {0x41, 2, 0x9B, 0x01, 0, 0, 0, 0, 0, 5, 51, 102, 255, 204, 255};
+  EXPECT_TRUE(bulb.light.parse_frame_(rgbww.data(), rgbww.size()));
+  bulb.loop();
+  EXPECT_NEAR(bulb.red.get_level(), 0.2f, 0.001f);
+  EXPECT_NEAR(bulb.green.get_level(), 0.4f, 0.001f);
+  EXPECT_NEAR(bulb.blue.get_level(), 1.0f, 0.001f);
+  EXPECT_NEAR(bulb.cold_white.get_level(), 0.8f, 0.001f);
+  EXPECT_NEAR(bulb.warm_white.get_level(), 1.0f, 0.001f);
+
+  // same for RGBW
+  const std::vector<uint8_t> rgbw = {0x41, 3, 0x1B, 0x01, 0, 0, 0, 0, 0, 4, 0, 0, 255, 0};
+  EXPECT_TRUE(bulb.light.parse_frame_(rgbw.data(), rgbw.size()));
+  bulb.loop();
+  EXPECT_NEAR(bulb.blue.get_level(), 1.0f, 0.001f);
+  EXPECT_EQ(bulb.cold_white.get_level(), 0.0f);
+}
@@ -0,0 +1,158 @@
+#include "dmx_packets.h"
+#include "kauf_bulb.h"
+#include "runner.h"
+
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::testing;
+using namespace esphome::testing::dmx;
+
+namespace {
+
+const uint16_t E131_PORT = 5568;
+const uint16_t ARTNET_PORT = 6454;
+/// KaufRGBWWLight::max_blue, RGB pixels blend like any RGB color and blue is scaled down by it.
+const float MAX_BLUE = 0.6f;
+
+}  // namespace
+
+TEST_CASE(e131_packet_sets_rgb) {
+  host::reset_network();
+  KaufBulb bulb("DMX", 0);
+  bulb.light.set_e131_universe(7);
+  bulb.light.set_dmx_start_channel(10);
+  bulb.setup();
+
+  const auto packet = e131_packet(7, universe_with(10, {255, 0, 51}));
+  EXPECT_TRUE(bulb.light.parse_e131_(packet.data(), packet.size()));
+  bulb.loop();
+  EXPECT_NEAR(bulb.red.get_level(), 1.0f, 0.002f);
+  EXPECT_EQ(bulb.green.get_level(), 0.0f);
+  EXPECT_NEAR(bulb.blue.get_level(), 0.2f * MAX_BLUE, 0.002f);
+  EXPECT_EQ(bulb.light.get_ddp_frames(), 1u);
+}
+
+TEST_CASE(e131_ignores_other_packets) {
+  KaufBulb bulb("DMX", 0);
+  bulb.light.set_e131_universe(7);
+  bulb.setup();
+  const auto dmx = universe_with(1, {255, 255, 255});
+
+  const auto other_universe = e131_packet(8, dmx);
+  const auto preview = e131_packet(7, dmx, 0x80);
+  const auto terminated = e131_packet(7, dmx, 0x40);
+  const auto priorities = e131_packet(7, dmx, 0, 0xDD);
+  auto wrong_id = e131_packet(7, dmx);
+  wrong_id[4] = 'X';
+  const auto not_acn = wrong_id;
+  const auto too_few_channels = e131_packet(7, {255, 255});
+  for (const auto *packet : {&other_universe, &preview, &terminated, &priorities, &not_acn, &too_few_channels})
+    EXPECT_TRUE(!bulb.light.parse_e131_(packet->data(), packet->size()));
+  const auto truncated = e131_packet(7, dmx);
+  EXPECT_TRUE(!bulb.light.parse_e131_(truncated.data(), 100));
+  EXPECT_EQ(bulb.light.get_ddp_frames(), 0u);
+}
+
+TEST_CASE(artnet_packet_sets_rgbww) {
+  KaufBulb bulb("DMX", 0);
+  bulb.light.set_artnet_universe(0x123);
+  bulb.light.set_dmx_channels(5);
+  bulb.setup();
+
+  const auto packet = artnet_packet(0x123, universe_with(1, {0, 0, 0, 102, 204}));
+  EXPECT_TRUE(bulb.light.parse_artnet_(packet.data(), packet.size()));
+  bulb.loop();
+  EXPECT_EQ(bulb.red.get_level(), 0.0f);
+  EXPECT_NEAR(bulb.cold_white.get_level(), 0.4f, 0.002f);
+  EXPECT_NEAR(bulb.warm_white.get_level(), 0.8f, 0.002f);
+}
+
+TEST_CASE(artnet_ignores_other_packets) {
+  KaufBulb bulb("DMX", 0);
+  bulb.light.set_artnet_universe(1);
+  bulb.setup();
+  const auto dmx = universe_with(1, {255, 255, 255});
+
+  const auto other_universe = artnet_packet(2, dmx);
+  const auto poll = artnet_packet(1, dmx, 0x2000);
+  auto wrong_id = artnet_packet(1, dmx);
+  wrong_id[0] = 'X';
+  const auto not_artnet = wrong_id;
+  const auto too_few_channels = artnet_packet(1, {255});
+  for (const auto *packet : {&other_universe, &poll, &not_artnet, &too_few_channels})
+    EXPECT_TRUE(!bulb.light.parse_artnet_(packet->data(), packet->size()));
+  EXPECT_EQ(bulb.light.get_ddp_frames(), 0u);
+}
+
+TEST_CASE(e131_waits_for_wifi_before_joining) {
+  host::reset_network();
+  host::set_wifi_connected(false);
+  KaufBulb bulb("DMX", 0);
+  bulb.light.set_e131_universe(1);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  bulb.run_for(3000);
+  EXPECT_EQ(host::bound_sockets(E131_PORT), 0);
+
+  // restored at boot before WiFi came up: joins the group once connected
+  host::set_wifi_connected(true);
+  bulb.run_for(1100);
+  EXPECT_EQ(host::bound_sockets(E131_PORT), 1);
+  host::send_to_group(IPAddress(239, 255, 0, 1), E131_PORT, e131_packet(1, universe_with(1, {0, 255, 0})));
+  bulb.loop();
+  EXPECT_NEAR(bulb.green.get_level(), 1.0f, 0.002f);
+  host::reset_network();
+}
+
+TEST_CASE(e131_rejoins_after_wifi_reconnect) {
+  host::reset_network();
+  KaufBulb bulb("DMX", 0);
+  bulb.light.set_e131_universe(1);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  bulb.run_for(100);
+  EXPECT_EQ(host::bound_sockets(E131_PORT), 1);
+
+  host::set_wifi_connected(false);
+  bulb.run_for(2000);
+  host::set_wifi_connected(true);
+  bulb.run_for(1100);
+
+  host::send_to_group(IPAddress(239, 255, 0, 1), E131_PORT, e131_packet(1, universe_with(1, {0, 0, 255})));
+  bulb.loop();
+  EXPECT_NEAR(bulb.blue.get_level(), MAX_BLUE, 0.002f);
+  EXPECT_EQ(host::bound_sockets(E131_PORT), 1);
+  host::reset_network();
+}
+
+TEST_CASE(artnet_receives_through_its_port) {
+  host::reset_network();
+  KaufBulb bulb("DMX", 0);
+  bulb.light.set_artnet_universe(0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  bulb.loop();
+  EXPECT_EQ(host::bound_sockets(ARTNET_PORT), 1);
+
+  host::send_to_port(ARTNET_PORT, artnet_packet(0, universe_with(1, {255, 0, 0})));
+  bulb.loop();
+  EXPECT_NEAR(bulb.red.get_level(), 1.0f, 0.002f);
+  host::reset_network();
+}
+
+TEST_CASE(artnet_retries_a_failed_bind) {
+  host::reset_network();
+  host::block_port(ARTNET_PORT, true);
+  KaufBulb bulb("DMX", 0);
+  bulb.light.set_artnet_universe(0);
+  bulb.setup();
+  bulb.light.set_use_wled(true);
+  bulb.run_for(2000);
+  EXPECT_EQ(host::bound_sockets(ARTNET_PORT), 0);
+
+  host::block_port(ARTNET_PORT, false);
+  bulb.run_for(1100);
+  EXPECT_EQ(host::bound_sockets(ARTNET_PORT), 1);
+  host::reset_network();
+}
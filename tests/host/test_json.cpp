@@ -0,0 +1,160 @@
+#include "esphome/components/light/light_json_schema.h"
+#include "esphome/core/log.h"
+#include "json_reference.h"
+#include "kauf_bulb.h"
+#include "runner.h"
+
+#include <cstdio>
+#include <string>
+
+using namespace esphome;
+using namespace esphome::light;
+using namespace esphome::testing;
+
+namespace {
+
+class Random {
+ public:
+  uint32_t next(uint32_t range) {
+    this->state_ = this->state_ * 1103515245u + 12345u;
+    return (this->state_ >> 8) % range;
+  }
+
+ protected:
+  uint32_t state_{0x150D};
+};
+
+/// A JSON command with a random subset of the schema's keys in random order, some with values of the wrong type.
+std::string random_command(Random &random) {
+  static const char *const KEYS[] = {"state", "brightness", "color", "white_value", "color_temp",
+                                     "flash", "transition", "effect", "unknown"};
+  static const char *const STATES[] = {"\"ON\"", "\"OFF\"", "\"on\"", "\"Toggle\"", "\"maybe\"", "1", "true"};
+  static const char *const COLOR_KEYS[] = {"r", "g", "b", "c", "w", "x", "rg"};
+  static const char *const EFFECTS[] = {"\"None\"", "\"Missing\"", "3"};
+
+  bool used[9] = {};
+  std::string json = "{";
+  const uint32_t count = random.next(10);
+  for (uint32_t i = 0; i < count; i++) {
+    const uint32_t key = random.next(9);
+    if (used[key])
+      continue;
+    used[key] = true;
+    if (json.size() > 1)
+      json += ',';
+    json += '"';
+    json += KEYS[key];
+    json += "\":";
+    char value[16];
+    switch (key) {
+      case 0:
+        json += STATES[random.next(7)];
+        break;
+      case 2:
+        if (random.next(8) == 0) {
+          json += "255";  // not an object
+          break;
+        }
+        json += '{';
+        for (uint32_t c = 0, used_color = 0; c < 7; c++) {
+          if (random.next(2) == 0)
+            continue;
+          snprintf(value, sizeof(value), "%s\"%s\":%u", used_color++ ? "," : "", COLOR_KEYS[c], random.next(256));
+          json += value;
+        }
+        json += '}';
+        break;
+      case 4:
+        snprintf(value, sizeof(value), "%u", 100 + random.next(500));
+        json += value;
+        break;
+      case 5:
+      case 6:
+        snprintf(value, sizeof(value), "%.2f", random.next(300) / 100.0f);
+        json += value;
+        break;
+      case 7:
+        json += EFFECTS[random.next(3)];
+        break;
+      default:
+        if (random.next(10) == 0) {
+          json += "\"128\"";  // a number as a string
+        } else {
+          snprintf(value, sizeof(value), random.next(2) ? "%u" : "%u.5", random.next(256));
+          json += value;
+        }
+        break;
+    }
+  }
+  return json + "}";
+}
+
+}  // namespace
+
+TEST_CASE(json_parse_matches_the_reference_parser) {
+  // the same random commands through parse_json() and the old parser, on two bulbs that must end up the same
+  KaufBulb bulb("Json", 0), reference("Json", 0);
+  bulb.setup();
+  reference.setup();
+  Random random;
+  DynamicJsonDocument doc(1024);
+  // most of the commands don't fit the light's color modes, and each bulb warns about them
+  host::set_log_level(ESPHOME_LOG_LEVEL_ERROR);
+  uint32_t mismatches = 0;
+  for (uint32_t i = 0; i < 3000 && mismatches < 5; i++) {
+    const std::string json = random_command(random);
+    EXPECT_TRUE(!deserializeJson(doc, json));
+    JsonObject root = doc.as<JsonObject>();
+
+    // every other command to the RGBW aux light, the main light has no white channel of its own
+    LightState &light = i % 2 ? bulb.warm_rgb : bulb.light;
+    LightState &reference_light = i % 2 ? reference.warm_rgb : reference.light;
+    LightCall call = light.make_call();
+    LightJSONSchema::parse_json(light, call, root);
+    call.perform();
+    LightCall reference_call = reference_light.make_call();
+    json::parse_json_by_lookup(reference_light, reference_call, root);
+    reference_call.perform();
+    // on the one simulated clock, so both run their transitions and flashes in step
+    for (uint32_t t = 0; t < 160; t += 16) {
+      host::advance_ms(16);
+      bulb.loop();
+      reference.loop();
+    }
+
+    float levels[5], reference_levels[5];
+    bulb.levels(levels);
+    reference.levels(reference_levels);
+    bool same = light.remote_values == reference_light.remote_values &&
+                light.get_effect_name() == reference_light.get_effect_name();
+    for (uint8_t c = 0; c < 5; c++)
+      same = same && levels[c] == reference_levels[c];
+    if (!same) {
+      printf("    differs after %s\n", json.c_str());
+      mismatches++;
+    }
+  }
+  host::set_log_level(ESPHOME_LOG_LEVEL);
+  EXPECT_EQ(mismatches, 0u);
+}
+
+TEST_CASE(json_ignores_state_and_effect_that_arent_strings) {
+  KaufBulb bulb("Json", 0);
+  bulb.setup();
+  DynamicJsonDocument doc(256);
+  EXPECT_TRUE(!deserializeJson(doc, "{\"state\":1,\"effect\":3,\"brightness\":128}"));
+  LightCall call = bulb.light.make_call();
+  LightJSONSchema::parse_json(bulb.light, call, doc.as<JsonObject>());
+  call.perform();
+  EXPECT_TRUE(!bulb.light.remote_values.is_on());
+  EXPECT_NEAR(bulb.light.remote_values.get_brightness(), 128.0f / 255.0f, 0.001f);
+  EXPECT_EQ(bulb.light.get_effect_name(), std::string("None"));
+
+  // the white_value of the legacy API still wins over color.w, wherever it is in the document
+  EXPECT_TRUE(!deserializeJson(doc, "{\"white_value\":51,\"state\":\"ON\",\"color\":{\"w\":255}}"));
+  LightCall white = bulb.warm_rgb.make_call();
+  LightJSONSchema::parse_json(bulb.warm_rgb, white, doc.as<JsonObject>());
+  white.perform();
+  EXPECT_TRUE(bulb.warm_rgb.remote_values.is_on());
+  EXPECT_NEAR(bulb.warm_rgb.remote_values.get_white(), 0.2f, 0.001f);
+}
@@ -0,0 +1,70 @@
+#include "kauf_bulb.h"
+#include "runner.h"
+
+using namespace esphome;
+using namespace esphome::testing;
+
+TEST_CASE(kauf_bulb_starts_off) {
+  KaufBulb bulb;
+  bulb.setup();
+  float levels[5];
+  bulb.levels(levels);
+  for (float level : levels)
+    EXPECT_EQ(level, 0.0f);
+}
+
+TEST_CASE(kauf_bulb_color_temperature_reaches_target) {
+  KaufBulb bulb;
+  bulb.setup();
+  bulb.light.turn_on().set_color_temperature(250.0f).set_brightness(1.0f).perform();
+  bulb.run_for(1100);
+
+  // halfway between cold (150) and warm (350) mireds, full brightness: both whites at half, no color
+  EXPECT_EQ(bulb.red.get_level(), 0.0f);
+  EXPECT_EQ(bulb.green.get_level(), 0.0f);
+  EXPECT_EQ(bulb.blue.get_level(), 0.0f);
+  EXPECT_NEAR(bulb.cold_white.get_level(), 0.5f, 0.002f);
+  EXPECT_NEAR(bulb.warm_white.get_level(), 0.5f, 0.002f);
+}
+
+TEST_CASE(kauf_bulb_transition_is_gradual) {
+  KaufBulb bulb;
+  bulb.setup();
+  bulb.light.turn_on().set_rgb(1.0f, 0.0f, 0.0f).set_brightness(1.0f).perform();
+  bulb.run_for(496);
+  const float halfway = bulb.red.get_level();
+  bulb.run_for(600);
+
+  EXPECT_TRUE(halfway > 0.05f && halfway < 0.95f);
+  EXPECT_NEAR(bulb.red.get_level(), 1.0f, 0.002f);
+  EXPECT_EQ(bulb.cold_white.get_level(), 0.0f);
+}
+
+TEST_CASE(kauf_bulb_turns_off) {
+  KaufBulb bulb("Bulb", 0);
+  bulb.setup();
+  bulb.light.turn_on().set_rgb(0.0f, 1.0f, 0.0f).perform();
+  bulb.run_for(32);
+  EXPECT_TRUE(bulb.green.get_level() > 0.9f);
+
+  bulb.light.turn_off().perform();
+  bulb.run_for(32);
+  EXPECT_EQ(bulb.green.get_level(), 0.0f);
+}
+
+TEST_CASE(light_state_restores_from_preferences) {
+  {
+    KaufBulb bulb("Restored");
+    bulb.light.set_restore_mode(light::LIGHT_RESTORE_DEFAULT_OFF);
+    bulb.setup();
+    bulb.light.turn_on().set_color_temperature(350.0f).set_brightness(0.5f).perform();
+    bulb.run_for(1100);
+  }
+
+  KaufBulb bulb("Restored");
+  bulb.light.set_restore_mode(light::LIGHT_RESTORE_DEFAULT_OFF);
+  bulb.setup();
+  EXPECT_TRUE(bulb.light.remote_values.is_on());
+  EXPECT_NEAR(bulb.light.remote_values.get_brightness(), 0.5f, 1e-6f);
+  EXPECT_NEAR(bulb.light.remote_values.get_color_temperature(), 350.0f, 1e-3f);
+}
@@ -0,0 +1,279 @@
+#include "kauf_bulb.h"
+#include "runner.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::testing;
+
+namespace {
+
+const char *const FOLLOWER_IP = "192.168.1.60";
+const uint16_t DDP_PORT = 4048;
+/// 16 bit levels in the leader's packets.
+const float LEVEL_RESOLUTION = 1.0f / 65535.0f;
+
+/// Hand everything the leader sent since the last call to the follower, as the network would.
+void forward(KaufBulb &follower) {
+  for (const auto &packet : host::sent_packets()) {
+    if (packet.host == FOLLOWER_IP && packet.port == DDP_PORT)
+      host::send_to_port(DDP_PORT, packet.data);
+  }
+  host::sent_packets().clear();
+}
+
+float max_difference(const KaufBulb &a, const KaufBulb &b) {
+  float la[5], lb[5];
+  a.levels(la);
+  b.levels(lb);
+  float difference = 0.0f;
+  for (uint8_t i = 0; i < 5; i++)
+    difference = std::max(difference, std::fabs(la[i] - lb[i]));
+  return difference;
+}
+
+}  // namespace
+
+TEST_CASE(leader_sends_its_output_levels) {
+  host::reset_network();
+  KaufBulb leader("Leader", 0);
+  leader.output.add_ddp_follower(FOLLOWER_IP);
+  leader.setup();
+  host::sent_packets().clear();
+
+  leader.light.turn_on().set_rgb(1.0f, 0.5f, 0.0f).set_brightness(1.0f).perform();
+  leader.loop();
+
+  // one timecoded 16 bit RGB + cold white + warm white pixel per write
+  EXPECT_EQ(host::sent_packets().size(), 1u);
+  const auto &packet = host::sent_packets()[0].data;
+  EXPECT_EQ(host::sent_packets()[0].port, DDP_PORT);
+  EXPECT_EQ(packet.size(), 24u);
+  EXPECT_EQ(packet[0], 0x51);
+  EXPECT_EQ(packet[2], 0x9C);
+  EXPECT_EQ(packet[9], 10);
+  EXPECT_NEAR(((packet[14] << 8) | packet[15]) / 65535.0f, leader.red.get_level(), LEVEL_RESOLUTION);
+  EXPECT_NEAR(((packet[16] << 8) | packet[17]) / 65535.0f, leader.green.get_level(), LEVEL_RESOLUTION);
+  host::reset_network();
+}
+
+TEST_CASE(follower_matches_the_leader_through_a_transition) {
+  host::reset_network();
+  KaufBulb leader("Leader", 1000);
+  KaufBulb follower("Follower", 0);
+  leader.output.add_ddp_follower(FOLLOWER_IP);
+  leader.setup();
+  follower.setup();
+  follower.light.set_use_wled(true);
+  follower.loop();  // binds the DDP port
+
+  // a transition across colors and whites, every step of it blended by the leader
+  leader.light.turn_on().set_rgb(0.2f, 0.4f, 1.0f).set_brightness(0.8f).perform();
+  leader.warm_rgb.turn_on().set_rgb(1.0f, 0.0f, 0.0f).set_brightness(0.5f).perform();
+  float worst = 0.0f;
+  for (uint32_t t = 0; t < 1200; t += 16) {
+    host::advance_ms(16);
+    leader.loop();
+    forward(follower);
+    follower.loop();
+    worst = std::max(worst, max_difference(leader, follower));
+  }
+  leader.light.turn_on().set_color_temperature(300.0f).set_brightness(0.6f).perform();
+  for (uint32_t t = 0; t < 1200; t += 16) {
+    host::advance_ms(16);
+    leader.loop();
+    forward(follower);
+    follower.loop();
+    worst = std::max(worst, max_difference(leader, follower));
+  }
+
+  // the follower writes the levels straight to its outputs, no brightness, gamma or calibration on top
+  EXPECT_TRUE(worst <= LEVEL_RESOLUTION);
+  EXPECT_TRUE(follower.warm_white.get_level() > 0.0f);
+  EXPECT_EQ(follower.light.get_ddp_seq_gaps(), 0u);
+  host::reset_network();
+}
+
+TEST_CASE(follower_with_jitter_buffer_stays_in_sync) {
+  host::reset_network();
+  KaufBulb leader("Leader", 1000);
+  KaufBulb follower("Follower", 0);
+  leader.output.add_ddp_follower(FOLLOWER_IP);
+  leader.setup();
+  follower.setup();
+  follower.light.set_use_wled(true);
+  follower.light.set_ddp_jitter_buffer(30);
+  follower.loop();
+  host::sent_packets().clear();
+
+  // The leader writes every 16 ms loop and each packet is delivered 0-15 ms later, in order. The follower schedules
+  // the frames by their timecode, so it shows the leader's levels the buffer length later whatever the delay.
+  leader.light.turn_on().set_rgb(1.0f, 0.0f, 0.0f).set_brightness(1.0f).perform();
+  std::vector<float> leader_red, follower_red;
+  std::vector<std::pair<uint32_t, std::vector<uint8_t>>> in_flight;
+  uint32_t random = 0xDDB0, last_delivery = 0;
+  for (uint32_t t = 0; t < 1200; t++) {
+    host::advance_ms(1);
+    if (t % 16 == 0) {
+      leader.loop();
+      leader_red.push_back(leader.red.get_level());
+      for (const auto &packet : host::sent_packets()) {
+        random = random * 1103515245u + 12345u;
+        last_delivery = std::max(last_delivery, t + (random >> 16) % 16);
+        in_flight.emplace_back(last_delivery, packet.data);
+      }
+      host::sent_packets().clear();
+    }
+    while (!in_flight.empty() && in_flight.front().first <= t) {
+      host::send_to_port(DDP_PORT, in_flight.front().second);
+      in_flight.erase(in_flight.begin());
+    }
+    follower.loop();
+    follower_red.push_back(follower.red.get_level());
+  }
+
+  // the follower interpolates between the leader's frames, compare with that
+  auto leader_at = [&leader_red](uint32_t t) {
+    const uint32_t frame = t / 16;
+    return leader_red[frame] + (leader_red[frame + 1] - leader_red[frame]) * (t % 16) / 16.0f;
+  };
+  float worst = 0.0f;
+  for (uint32_t t = 100; t < 1100; t++)
+    worst = std::max(worst, std::fabs(follower_red[t] - leader_at(t - 30)));
+  // within the 0.001 output resolution of both bulbs, a couple of milliseconds off would be a few times that
+  EXPECT_TRUE(worst < 0.0025f);
+  EXPECT_NEAR(follower.red.get_level(), 1.0f, 0.002f);
+  host::reset_network();
+}
+
+TEST_CASE(leader_resends_the_last_levels_every_second) {
+  host::reset_network();
+  KaufBulb leader("Leader", 0);
+  KaufBulb follower("Follower", 0);
+  leader.output.add_ddp_follower(FOLLOWER_IP);
+  leader.setup();
+  follower.setup();
+  follower.light.set_use_wled(true);
+  follower.loop();
+
+  // the packet with the new levels is lost
+  leader.light.turn_on().set_rgb(0.0f, 1.0f, 0.0f).set_brightness(1.0f).perform();
+  leader.loop();
+  host::sent_packets().clear();
+
+  // nothing changes, the leader repeats the levels once a second (at its next loop) with new sequence numbers
+  uint32_t resent = 0;
+  uint8_t last_seq = 0;
+  for (uint32_t t = 0; t < 3100; t += 16) {
+    host::advance_ms(16);
+    leader.loop();
+    for (const auto &packet : host::sent_packets()) {
+      EXPECT_TRUE(packet.data[1] != last_seq);
+      last_seq = packet.data[1];
+      resent++;
+    }
+    forward(follower);
+    follower.loop();
+  }
+  EXPECT_EQ(resent, 3u);
+  EXPECT_TRUE(max_difference(leader, follower) <= LEVEL_RESOLUTION);
+  host::reset_network();
+}
+
+namespace {
+
+/// First millisecond the red output reached half.
+uint32_t red_crossing(const std::vector<float> &red) {
+  for (uint32_t t = 0; t < red.size(); t++) {
+    if (red[t] >= 0.5f)
+      return t;
+  }
+  return red.size();
+}
+
+}  // namespace
+
+TEST_CASE(follower_skew_against_independent_commands) {
+  // Two bulbs fading red in over a second, their 16 ms loops out of phase. Home Assistant sends a command to each
+  // bulb on its own, the second one 0-100 ms after the first. A follower instead gets every frame from the leader,
+  // 1-10 ms over the network. The skew is when each bulb's red passes half.
+  uint32_t random = 0x5EED;
+  auto next_random = [&random](uint32_t range) {
+    random = random * 1103515245u + 12345u;
+    return (random >> 16) % range;
+  };
+  const uint32_t trials = 20;
+  float independent_total = 0.0f, independent_worst = 0.0f, follower_total = 0.0f, follower_worst = 0.0f;
+  for (uint32_t trial = 0; trial < trials; trial++) {
+    const uint32_t phase = 1 + next_random(15);
+
+    host::reset_network();
+    KaufBulb a("A", 1000), b("B", 1000);
+    a.setup();
+    b.setup();
+    const uint32_t command_delay = next_random(101);
+    std::vector<float> red_a, red_b;
+    for (uint32_t t = 0; t < 1500; t++) {
+      host::advance_ms(1);
+      if (t == 0)
+        a.light.turn_on().set_rgb(1.0f, 0.0f, 0.0f).set_brightness(1.0f).perform();
+      if (t == command_delay)
+        b.light.turn_on().set_rgb(1.0f, 0.0f, 0.0f).set_brightness(1.0f).perform();
+      if (t % 16 == 0)
+        a.loop();
+      if (t % 16 == phase)
+        b.loop();
+      red_a.push_back(a.red.get_level());
+      red_b.push_back(b.red.get_level());
+    }
+    const float independent = std::fabs(float(red_crossing(red_b)) - float(red_crossing(red_a)));
+    independent_total += independent;
+    independent_worst = std::max(independent_worst, independent);
+
+    host::reset_network();
+    KaufBulb leader("Leader", 1000), follower("Follower", 0);
+    leader.output.add_ddp_follower(FOLLOWER_IP);
+    leader.setup();
+    follower.setup();
+    follower.light.set_use_wled(true);
+    follower.loop();
+    host::sent_packets().clear();
+    std::vector<std::pair<uint32_t, std::vector<uint8_t>>> in_flight;
+    uint32_t last_delivery = 0;
+    std::vector<float> red_leader, red_follower;
+    for (uint32_t t = 0; t < 1500; t++) {
+      host::advance_ms(1);
+      if (t == 0)
+        leader.light.turn_on().set_rgb(1.0f, 0.0f, 0.0f).set_brightness(1.0f).perform();
+      if (t % 16 == 0) {
+        leader.loop();
+        for (const auto &packet : host::sent_packets()) {
+          last_delivery = std::max(last_delivery, t + 1 + next_random(10));
+          in_flight.emplace_back(last_delivery, packet.data);
+        }
+        host::sent_packets().clear();
+      }
+      while (!in_flight.empty() && in_flight.front().first <= t) {
+        host::send_to_port(DDP_PORT, in_flight.front().second);
+        in_flight.erase(in_flight.begin());
+      }
+      if (t % 16 == phase)
+        follower.loop();
+      red_leader.push_back(leader.red.get_level());
+      red_follower.push_back(follower.red.get_level());
+    }
+    const float followed = std::fabs(float(red_crossing(red_follower)) - float(red_crossing(red_leader)));
+    follower_total += followed;
+    follower_worst = std::max(follower_worst, followed);
+  }
+  host::reset_network();
+
+  printf("    independent commands: mean skew %.1f ms, worst %.1f ms\n", independent_total / trials, independent_worst);
+  printf("    leader and follower:  mean skew %.1f ms, worst %.1f ms\n", follower_total / trials, follower_worst);
+  // a follower is behind by the network delay plus the wait for its next loop, never more than one loop and the
+  // slowest packet
+  EXPECT_TRUE(follower_worst <= 16.0f + 10.0f);
+  EXPECT_TRUE(follower_total < independent_total);
+}
@@ -0,0 +1,36 @@
+#include "kauf_bulb.h"
+#include "runner.h"
+
+using namespace esphome;
+using namespace esphome::testing;
+
+TEST_CASE(light_call_clamps_out_of_range_values) {
+  KaufBulb bulb("Call", 0);
+  bulb.setup();
+  bulb.light.turn_on().set_rgb(1.5f, -0.5f, 0.5f).set_brightness(2.0f).perform();
+  const auto &values = bulb.light.remote_values;
+  EXPECT_EQ(values.get_red(), 1.0f);
+  EXPECT_EQ(values.get_green(), 0.0f);
+  EXPECT_EQ(values.get_blue(), 0.5f);
+  EXPECT_EQ(values.get_brightness(), 1.0f);
+
+  // color temperature is clamped to the mireds of the light instead of 0-1
+  const auto traits = bulb.light.get_traits();
+  bulb.light.turn_on().set_color_temperature(1000.0f).perform();
+  EXPECT_EQ(bulb.light.remote_values.get_color_temperature(), traits.get_max_mireds());
+  bulb.light.turn_on().set_color_temperature(1.0f).perform();
+  EXPECT_EQ(bulb.light.remote_values.get_color_temperature(), traits.get_min_mireds());
+}
+
+TEST_CASE(light_call_leaves_unset_fields_alone) {
+  KaufBulb bulb("Call", 0);
+  bulb.setup();
+  bulb.light.turn_on().set_rgb(0.2f, 0.4f, 0.6f).set_brightness(0.5f).perform();
+  bulb.light.turn_on().set_green(0.8f).perform();
+  const auto &values = bulb.light.remote_values;
+  // the first call was normalized to full blue, the second only replaces green
+  EXPECT_NEAR(values.get_red(), 0.2f / 0.6f, 0.001f);
+  EXPECT_NEAR(values.get_green(), 0.8f, 0.001f);
+  EXPECT_NEAR(values.get_blue(), 1.0f, 0.001f);
+  EXPECT_EQ(values.get_brightness(), 0.5f);
+}
@@ -0,0 +1,47 @@
+#include "kauf_bulb.h"
+#include "esphome/components/light/automation.h"
+#include "runner.h"
+
+using namespace esphome;
+using namespace esphome::testing;
+using light::LightState;
+
+TEST_CASE(loop_profiler_records_only_enabled_lights) {
+  KaufBulb bulb("Profiled", 200);
+  bulb.light.set_loop_profiler(true);
+  bulb.setup();
+  bulb.light.turn_on().set_rgb(1.0f, 0.0f, 0.0f).perform();
+  bulb.run_for(300);
+
+  EXPECT_TRUE(bulb.light.get_loop_profile_count(LightState::LOOP_STAGE_TRANSFORMER) > 10);
+  EXPECT_TRUE(bulb.light.get_loop_profile_count(LightState::LOOP_STAGE_WRITE) > 10);
+  EXPECT_EQ(bulb.light.get_loop_profile_count(LightState::LOOP_STAGE_WLED), 0u);
+  EXPECT_TRUE(bulb.light.get_loop_profile_mean_cycles(LightState::LOOP_STAGE_WRITE) > 0.0f);
+  // the aux lights of the same bulb didn't enable it
+  EXPECT_EQ(bulb.warm_rgb.get_loop_profile_count(LightState::LOOP_STAGE_WRITE), 0u);
+  EXPECT_EQ(bulb.warm_rgb.get_loop_profile_mean_cycles(LightState::LOOP_STAGE_WRITE), 0.0f);
+
+  bulb.light.reset_loop_profile();
+  EXPECT_EQ(bulb.light.get_loop_profile_count(LightState::LOOP_STAGE_WRITE), 0u);
+  EXPECT_EQ(bulb.light.get_loop_profile_max_cycles(LightState::LOOP_STAGE_WRITE), 0u);
+}
+
+TEST_CASE(dump_loop_profile_action_logs_the_light) {
+  KaufBulb bulb("Profiled", 0);
+  bulb.light.set_loop_profiler(true);
+  bulb.setup();
+  bulb.run_for(50);
+
+  // with and without a profile, neither may touch the histograms
+  light::DumpLoopProfileAction<> dump(&bulb.light);
+  light::DumpLoopProfileAction<> dump_aux(&bulb.cold_rgb);
+  const uint32_t runs = bulb.light.get_loop_profile_count(LightState::LOOP_STAGE_WRITE);
+  dump.play_complex();
+  dump_aux.play_complex();
+  EXPECT_EQ(bulb.light.get_loop_profile_count(LightState::LOOP_STAGE_WRITE), runs);
+
+  bulb.light.set_loop_profiler(false);
+  EXPECT_EQ(bulb.light.get_loop_profile_count(LightState::LOOP_STAGE_WRITE), 0u);
+  bulb.run_for(50);
+  EXPECT_EQ(bulb.light.get_loop_profile_count(LightState::LOOP_STAGE_WRITE), 0u);
+}
@@ -0,0 +1,115 @@
+#include "kauf_bulb.h"
+#include "runner.h"
+
+#include <cstdio>
+
+using namespace esphome;
+using namespace esphome::light;
+using namespace esphome::testing;
+
+// LightState keeps one transition and one flash transformer and sets them up again for every call, these follow a
+// transformer from one call into the next.
+
+namespace {
+
+/// KaufRGBWWLight::max_blue, blue is scaled down by it.
+const float MAX_BLUE = 0.6f;
+
+void steady_red(KaufBulb &bulb) {
+  bulb.setup();
+  bulb.light.turn_on().set_rgb(1.0f, 0.0f, 0.0f).set_brightness(1.0f).perform();
+  bulb.run_for(1100);
+}
+
+}  // namespace
+
+TEST_CASE(transition_after_a_flash) {
+  KaufBulb bulb("Transformers", 1000);
+  steady_red(bulb);
+
+  bulb.light.turn_on().set_rgb(0.0f, 1.0f, 0.0f).set_flash_length(1000).perform();
+  bulb.run_for(496);
+  EXPECT_NEAR(bulb.green.get_level(), 1.0f, 0.002f);
+  bulb.run_for(600);
+  EXPECT_NEAR(bulb.red.get_level(), 1.0f, 0.002f);
+  EXPECT_EQ(bulb.green.get_level(), 0.0f);
+
+  // the transition transformer starts from the red the flash restored, not from where it was left before the flash
+  bulb.light.turn_on().set_rgb(0.0f, 0.0f, 1.0f).perform();
+  bulb.run_for(496);
+  EXPECT_TRUE(bulb.red.get_level() > 0.1f && bulb.red.get_level() < 0.9f);
+  EXPECT_TRUE(bulb.blue.get_level() > 0.1f * MAX_BLUE && bulb.blue.get_level() < 0.9f * MAX_BLUE);
+  bulb.run_for(600);
+  EXPECT_EQ(bulb.red.get_level(), 0.0f);
+  EXPECT_NEAR(bulb.blue.get_level(), MAX_BLUE, 0.002f);
+}
+
+TEST_CASE(flash_during_a_flash) {
+  KaufBulb bulb("Transformers", 1000);
+  steady_red(bulb);
+
+  bulb.light.turn_on().set_rgb(0.0f, 1.0f, 0.0f).set_flash_length(1000).perform();
+  bulb.run_for(304);
+  EXPECT_NEAR(bulb.green.get_level(), 1.0f, 0.002f);
+
+  // the second flash reuses the flash transformer, and still returns to the red from before the first one
+  bulb.light.turn_on().set_rgb(0.0f, 0.0f, 1.0f).set_flash_length(1000).perform();
+  bulb.run_for(496);
+  EXPECT_NEAR(bulb.blue.get_level(), MAX_BLUE, 0.002f);
+  EXPECT_EQ(bulb.green.get_level(), 0.0f);
+  bulb.run_for(600);
+  EXPECT_NEAR(bulb.red.get_level(), 1.0f, 0.002f);
+  EXPECT_EQ(bulb.green.get_level(), 0.0f);
+  EXPECT_EQ(bulb.blue.get_level(), 0.0f);
+}
+
+TEST_CASE(transition_interrupted_by_a_flash) {
+  KaufBulb bulb("Transformers", 1000);
+  steady_red(bulb);
+
+  bulb.light.turn_on().set_rgb(0.0f, 0.0f, 1.0f).perform();
+  bulb.run_for(400);
+  EXPECT_TRUE(bulb.red.get_level() > 0.1f && bulb.red.get_level() < 0.9f);
+
+  // a flash in the middle of a transition returns to where the transition started, as it always has
+  bulb.light.turn_on().set_rgb(0.0f, 1.0f, 0.0f).set_flash_length(600).perform();
+  bulb.run_for(304);
+  EXPECT_NEAR(bulb.green.get_level(), 1.0f, 0.002f);
+  bulb.run_for(400);
+  EXPECT_NEAR(bulb.red.get_level(), 1.0f, 0.002f);
+  EXPECT_EQ(bulb.blue.get_level(), 0.0f);
+
+  // and the transition transformer the flash cut short fades from there again
+  bulb.light.turn_on().set_rgb(0.0f, 0.0f, 1.0f).perform();
+  bulb.run_for(496);
+  EXPECT_TRUE(bulb.red.get_level() > 0.1f && bulb.red.get_level() < 0.9f);
+  bulb.run_for(600);
+  EXPECT_EQ(bulb.red.get_level(), 0.0f);
+  EXPECT_NEAR(bulb.blue.get_level(), MAX_BLUE, 0.002f);
+}
+
+TEST_CASE(transformers_allocate_only_once) {
+  KaufBulb bulb("Transformers", 1000);
+  steady_red(bulb);
+  bulb.light.turn_on().set_rgb(0.0f, 1.0f, 0.0f).set_flash_length(1000).perform();
+  bulb.run_for(1100);
+
+  // A call allocates for the light's traits whatever it does, so compare with a call without transition. With both
+  // transformers created, a transition or a flash, and every loop of it, adds nothing to that.
+  auto allocations = [&bulb](LightCall call) {
+    const uint64_t before = host::allocations();
+    call.perform();
+    bulb.run_for(1100);
+    return host::allocations() - before;
+  };
+  const uint64_t immediate = allocations(bulb.light.turn_on().set_rgb(1.0f, 0.0f, 0.0f).set_transition_length(0));
+  uint64_t transitions = 0, flashes = 0;
+  for (int i = 0; i < 10; i++) {
+    transitions += allocations(bulb.light.turn_on().set_rgb(0.0f, 0.0f, 1.0f)) - immediate;
+    flashes += allocations(bulb.light.turn_on().set_rgb(1.0f, 0.0f, 0.0f).set_flash_length(1000)) - immediate;
+  }
+  printf("    allocations per call: %llu, more for 10 transitions: %llu, for 10 flashes: %llu\n",
+         (unsigned long long) immediate, (unsigned long long) transitions, (unsigned long long) flashes);
+  EXPECT_EQ(transitions, 0u);
+  EXPECT_EQ(flashes, 0u);
+}